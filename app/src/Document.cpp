@@ -24,12 +24,55 @@
 
 constexpr size_t UNDO_LIMIT = 100;
 
+//Hands the result of a background open back to the main thread
+class app::Document::LoadCompleted final : public gui::ICommand
+{
+public:
+	LoadCompleted(Document& doc, std::unique_ptr<nif::File>&& file, std::string&& error) :
+		m_doc{ doc }, m_file{ std::move(file) }, m_error{ std::move(error) } {}
+
+	virtual void execute() override { m_doc.onLoaded(std::move(m_file), m_error); }
+	virtual void reverse() override {}
+	virtual bool reversible() const override { return false; }
+
+private:
+	Document& m_doc;
+	std::unique_ptr<nif::File> m_file;
+	const std::string m_error;
+};
+
+//Hands the result of a background save back to the main thread
+class app::Document::WriteCompleted final : public gui::ICommand
+{
+public:
+	WriteCompleted(Document& doc, std::string&& error) : m_doc{ doc }, m_error{ std::move(error) } {}
+
+	virtual void execute() override { m_doc.onWritten(m_error); }
+	virtual void reverse() override {}
+	virtual bool reversible() const override { return false; }
+
+private:
+	Document& m_doc;
+	const std::string m_error;
+};
+
 void app::Document::Invoker::invoke()
 {
+	{
+		std::lock_guard<std::mutex> lock(m_postMutex);
+		for (auto&& a : m_posted)
+			m_pending.push_back(std::move(a));
+		m_posted.clear();
+	}
+
 	while (!m_pending.empty()) {
 		auto&& a = m_pending.front();
 		assert(a);
-		a->execute();
+		{
+			//Listeners only need to hear the outcome of each command
+			nif::ChangeBatch batch;
+			a->execute();
+		}
 		if (a->reversible()) {
 			//erase undone actions
 			m_next = m_history.erase(m_next, m_history.end());//no-op if next == end
@@ -49,10 +92,17 @@ void app::Document::Invoker::queue(CommandPtr&& a)
 	m_pending.push_back(std::move(a));
 }
 
+void app::Document::Invoker::post(CommandPtr&& a)
+{
+	std::lock_guard<std::mutex> lock(m_postMutex);
+	m_posted.push_back(std::move(a));
+}
+
 void app::Document::Invoker::undo()
 {
 	if (m_next != m_history.begin()) {
 		--m_next;
+		nif::ChangeBatch batch;
 		(*m_next)->reverse();
 	}
 }
@@ -60,7 +110,10 @@ void app::Document::Invoker::undo()
 void app::Document::Invoker::redo()
 {
 	if (m_next != m_history.end()) {
-		(*m_next)->execute();
+		{
+			nif::ChangeBatch batch;
+			(*m_next)->execute();
+		}
 		++m_next;
 	}
 }
@@ -103,32 +156,70 @@ app::Document::Document(const gui::Floats<2>& size, const std::filesystem::path&
 	//Any exception that we DO catch (from the file io or the node editor constructor) 
 	//will result in an error message (modal) and an empty file.
 
-	try {
-		//If our backend nif io is robust we don't really need to check the file status here.
-		//But, as a general idea:
-		auto fileStatus = std::filesystem::status(path);
-		if (fileStatus.type() == std::filesystem::file_type::not_found)
-			throw std::runtime_error("File not found");
-		//(let's leave it at that for now)
-
-		m_file = std::make_unique<nif::File>(path);//may throw
-		m_nodeEditor = newChild<node::Editor>(m_size, *m_file);//should catch warnings, may throw serious errors
-	}
-	catch (const std::exception& e) {
-		m_file = std::make_unique<nif::File>();
-		m_nodeEditor = newChild<node::Editor>(m_size);
-		newChild<gui::MessageBox>("Error", e.what());
-	}
+	//The file is read on a worker, and handed back to us through our invoker (see onLoaded)
+	m_progress = newChild<gui::Text>("Loading " + path.filename().u8string() + "...");
+
+	m_loading = std::make_shared<LoadState>();
+	m_loading->doc = this;
+
+	std::thread(
+		[state = m_loading, path]()
+		{
+			std::unique_ptr<nif::File> file;
+			std::string error;
+			try {
+				if (state->cancelled)
+					return;
+
+				//If our backend nif io is robust we don't really need to check the file status here.
+				//But, as a general idea:
+				auto fileStatus = std::filesystem::status(path);
+				if (fileStatus.type() == std::filesystem::file_type::not_found)
+					throw std::runtime_error("File not found");
+				//(let's leave it at that for now)
+
+				file = std::make_unique<nif::File>(path);//may throw
+			}
+			catch (const std::exception& e) {
+				error = e.what();
+			}
+			catch (...) {
+				error = "Unknown error";
+			}
+
+			//If the document has gone away, the file is released here
+			std::lock_guard<std::mutex> lock(state->mutex);
+			if (state->doc)
+				state->doc->m_invoker.post(std::make_unique<LoadCompleted>(*state->doc, std::move(file), std::move(error)));
+		}).detach();
 }
 
 app::Document::~Document()
 {
+	//Abandon a half-finished open. The read itself runs to completion, but the worker drops the result.
+	if (m_loading) {
+		m_loading->cancelled = true;
+		std::lock_guard<std::mutex> lock(m_loading->mutex);
+		m_loading->doc = nullptr;
+	}
+
+	//The save keeps parts of our file alive, and posts back to us
+	if (m_writing.valid())
+		m_writing.wait();
+
 	clearChildren();
 }
 
 void app::Document::frame(gui::FrameDrawer& fd)
 {
 	m_invoker.invoke();
+
+	//A save requested while we were saving. Not from onWritten, since commands run inside a batch.
+	if (m_writeAgain && !m_writeJob) {
+		m_writeAgain = false;
+		write();
+	}
+
 	Composite::frame(fd);
 }
 
@@ -171,13 +262,69 @@ void app::Document::setFilePath(const std::filesystem::path& path)
 
 void app::Document::write()
 {
+	if (m_writeJob) {
+		//Coalesce with the save in progress. Whatever changes by the time it finishes goes in the next one.
+		m_writeAgain = true;
+		return;
+	}
+	if (!m_file || m_targetPath.empty())
+		return;
+
+	//Syncing is cheap compared to serialising, and must happen here while the model is not changing
 	try {
-		if (m_nodeEditor)
-			m_nodeEditor->preWriteProc();
-		if (m_file)
-			m_file->write(m_targetPath);
+		m_writeJob = m_nodeEditor ? m_nodeEditor->prepareWrite() : m_file->prepareWrite();
 	}
 	catch (const std::exception& e) {
 		addChild(std::make_unique<gui::MessageBox>("Error", e.what()));
 	}
+
+	if (m_writeJob) {
+		m_writing = std::async(std::launch::async,
+			[this, job = m_writeJob.get(), path = m_targetPath]()
+			{
+				std::string error;
+				try {
+					job->write(path);
+				}
+				catch (const std::exception& e) {
+					error = e.what();
+				}
+				catch (...) {
+					error = "Unknown error";
+				}
+				m_invoker.post(std::make_unique<WriteCompleted>(*this, std::move(error)));
+			});
+	}
+}
+
+void app::Document::onLoaded(std::unique_ptr<nif::File>&& file, const std::string& error)
+{
+	m_loading.reset();
+
+	removeChild(m_progress);
+	m_progress = nullptr;
+
+	try {
+		if (!file)
+			throw std::runtime_error(error);
+
+		m_file = std::move(file);
+		m_nodeEditor = newChild<node::Editor>(m_size, *m_file);//should catch warnings, may throw serious errors
+	}
+	catch (const std::exception& e) {
+		m_file = std::make_unique<nif::File>();
+		m_nodeEditor = newChild<node::Editor>(m_size);
+		newChild<gui::MessageBox>("Error", e.what());
+	}
+}
+
+void app::Document::onWritten(const std::string& error)
+{
+	m_writing.get();
+	m_writeJob.reset();
+
+	if (!error.empty())
+		addChild(std::make_unique<gui::MessageBox>("Error", error));
+
+	//m_writeAgain is picked up by the next frame
 }
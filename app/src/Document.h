@@ -17,11 +17,19 @@
 //along with SVFX Editor. If not, see <https://www.gnu.org/licenses/>.
 
 #pragma once
+#include <atomic>
 #include <filesystem>
+#include <future>
+#include <mutex>
 #include "IInvoker.h"
 #include "Composition.h"
 #include "File.h"
 
+namespace gui
+{
+	class Text;
+}
+
 namespace node
 {
 	class Editor;
@@ -50,8 +58,17 @@ namespace app
 		void undo() { m_invoker.undo(); }
 		void redo() { m_invoker.redo(); }
 
+		//Save in the background. Completion or failure is reported in a later frame.
+		//If we are already saving, we'll save again when that finishes.
 		void write();
 
+	private:
+		class LoadCompleted;
+		void onLoaded(std::unique_ptr<nif::File>&& file, const std::string& error);
+
+		class WriteCompleted;
+		void onWritten(const std::string& error);
+
 	private:
 		class Invoker final :
 			public gui::IInvoker
@@ -63,11 +80,16 @@ namespace app
 			virtual void undo() override;
 			virtual void redo() override;
 
+			//Queue a command from any thread. It will be executed on the next invoke().
+			void post(CommandPtr&& a);
+
 			bool empty() const { return m_pending.empty(); }
 			void clear();
 
 		private:
 			std::deque<CommandPtr> m_pending;
+			std::mutex m_postMutex;
+			std::vector<CommandPtr> m_posted;
 			std::list<CommandPtr> m_history;
 			std::list<CommandPtr>::iterator m_next{ m_history.begin() };
 		};
@@ -77,6 +99,21 @@ namespace app
 		std::filesystem::path m_targetPath;
 		node::Editor* m_nodeEditor{ nullptr };
 
+		//The open in progress, if any. The worker shares it, so we can abandon the open without waiting.
+		struct LoadState
+		{
+			std::atomic<bool> cancelled{ false };
+			std::mutex mutex;
+			Document* doc{ nullptr };//null once cancelled, guarded by mutex
+		};
+		std::shared_ptr<LoadState> m_loading;
+		gui::Text* m_progress{ nullptr };
+
+		//The save in progress, if any
+		std::unique_ptr<nif::File::WriteJob> m_writeJob;
+		std::future<void> m_writing;
+		bool m_writeAgain{ false };
+
 	};
 }
 
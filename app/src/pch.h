@@ -29,6 +29,7 @@
 #include <map>
 #include <memory>
 #include <queue>
+#include <thread>
 
 #define EIGEN_MPL2_ONLY
 #include "Eigen\Dense"
@@ -17,7 +17,15 @@
 //along with SVFX Editor. If not, see <https://www.gnu.org/licenses/>.
 
 #pragma once
-#include <set>
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <type_traits>
+#include <unordered_map>
 #include <vector>
 
 template<typename T>
@@ -39,53 +47,348 @@ public:
 	void unsub() {}
 };*/
 
+//While alive, Observables on this thread allocate their bookkeeping from resource.
+//Lets the owner of many Observables keep their allocations together.
+//Anything allocated from the resource keeps it alive, so Observables may outlive the scope and the owner.
+class ObservableArena
+{
+public:
+	ObservableArena(const std::shared_ptr<std::pmr::memory_resource>& resource) : m_resource{ resource }, m_previous{ s_current }
+	{
+		s_current = this;
+	}
+	ObservableArena(const ObservableArena&) = delete;
+	~ObservableArena() { s_current = m_previous; }
+
+	ObservableArena& operator=(const ObservableArena&) = delete;
+
+	//Null if there is no arena (use the default resource)
+	static std::shared_ptr<std::pmr::memory_resource> current() { return s_current ? s_current->m_resource : nullptr; }
+
+private:
+	inline static thread_local ObservableArena* s_current{ nullptr };
+	const std::shared_ptr<std::pmr::memory_resource> m_resource;
+	ObservableArena* const m_previous;
+};
+
+//Specialise for observables whose events can be collapsed (see Observable::signalLatest).
+//Should return the event that describes the current state of the observable. before is the state
+//it was in before the first of the collapsed events, as passed to signalLatest, or null.
+template<typename T>
+struct LatestEvent;
+
+//While alive, collapsible signals on this thread are held back and delivered once, in the order
+//they were first raised, when the outermost batch is destroyed.
+//Events that can't be collapsed are unaffected.
+class ObservableBatch
+{
+	template<typename T> friend class Observable;
+
+public:
+	//Observables may hand us this much of the state they were in before we held them back
+	constexpr static size_t STATE_SIZE = 16;
+	template<typename S>
+	constexpr static bool can_hold = std::is_trivially_copyable_v<S> && sizeof(S) <= STATE_SIZE && alignof(S) <= alignof(std::max_align_t);
+
+private:
+	struct Pending
+	{
+		void* observable;
+		void (*deliver)(void*, const void*);
+		bool hasBefore;
+		alignas(std::max_align_t) unsigned char before[STATE_SIZE];
+	};
+
+public:
+	//Tag for a batch that delivers its own signals when it ends, even inside another batch.
+	//Signals already held back by the enclosing batch stay there.
+	struct Isolated {};
+
+	ObservableBatch() : m_outermost{ s_current == nullptr }
+	{
+		if (m_outermost)
+			s_current = this;
+	}
+	ObservableBatch(Isolated) : m_outermost{ true }, m_enclosing{ s_current },
+		m_base{ s_current ? s_current->m_base + static_cast<unsigned int>(s_current->m_pending.size()) : 0 }
+	{
+		s_current = this;
+	}
+	ObservableBatch(const ObservableBatch&) = delete;
+	~ObservableBatch()
+	{
+		if (m_outermost) {
+			//Anything signalled while we deliver is delivered immediately
+			m_delivering = true;
+			for (size_t i = 0; i < m_pending.size(); i++) {
+				if (void* observable = m_pending[i].observable) {
+					m_pending[i].observable = nullptr;
+					m_pending[i].deliver(observable, m_pending[i].hasBefore ? m_pending[i].before : nullptr);
+				}
+			}
+			s_current = m_enclosing;
+		}
+	}
+
+	ObservableBatch& operator=(const ObservableBatch&) = delete;
+
+	//Is a batch holding back signals on this thread?
+	static bool active() { return s_current && !s_current->m_delivering; }
+
+private:
+	//Returns the (one-based) id of the new entry. Ids are unique across isolated batches,
+	//since an enclosing batch can't add entries while we are active.
+	unsigned int add(void* observable, void (*deliver)(void*, const void*), const void* before, size_t size)
+	{
+		assert(active());
+		assert(size <= STATE_SIZE);
+		Pending& p = m_pending.emplace_back();
+		p.observable = observable;
+		p.deliver = deliver;
+		p.hasBefore = before != nullptr;
+		if (before)
+			std::memcpy(p.before, before, size);
+		return m_base + static_cast<unsigned int>(m_pending.size());
+	}
+	void move(unsigned int id, void* to)
+	{
+		entry(id).observable = to;
+	}
+	void drop(unsigned int id)
+	{
+		entry(id).observable = nullptr;
+	}
+
+	//The entry may belong to an enclosing batch
+	Pending& entry(unsigned int id)
+	{
+		ObservableBatch* batch = this;
+		while (id <= batch->m_base) {
+			batch = batch->m_enclosing;
+			assert(batch);
+		}
+		assert(id > batch->m_base && id - batch->m_base <= batch->m_pending.size());
+		return batch->m_pending[id - batch->m_base - 1];
+	}
+
+	static ObservableBatch& current()
+	{
+		//Observables must not leave the thread they have pending signals on
+		assert(s_current);
+		return *s_current;
+	}
+
+private:
+	inline static thread_local ObservableBatch* s_current{ nullptr };
+	const bool m_outermost;
+	ObservableBatch* const m_enclosing{ nullptr };
+	const unsigned int m_base{ 0 };//ids below this belong to m_enclosing
+	bool m_delivering{ false };
+	std::vector<Pending> m_pending;
+};
+
 template<typename T>
 class Observable
 {
+	//Most observables have no more than a couple of listeners. We store that many in place,
+	//and only allocate once there are more.
+	//Listeners are called in the order they were added, except that once we have overflowed, a
+	//removed listener's place is taken by the last one.
+	constexpr static unsigned int INLINE = 2;
+	constexpr static unsigned int OVERFLOWED = ~0u;
+
+	struct Overflow
+	{
+		Overflow(std::shared_ptr<std::pmr::memory_resource>&& owner, std::pmr::memory_resource* resource) :
+			owner{ std::move(owner) }, listeners{ resource }, slots{ resource }, work{ resource } {}
+
+		//Keeps the arena we were allocated from alive (null if it's the default resource)
+		std::shared_ptr<std::pmr::memory_resource> owner;
+		std::pmr::vector<IListener<T>*> listeners;
+		//The position of each listener in listeners, so that adding and removing needs no search
+		std::pmr::unordered_map<IListener<T>*, unsigned int> slots;
+		std::pmr::vector<IListener<T>*> work;
+		bool dirty{ true };
+	};
+
 public:
 	Observable() = default;
 	Observable(const Observable&) = delete;
 	Observable(Observable&& other) noexcept { *this = std::move(other); }
 
-	~Observable() = default;
+	~Observable() { release(); }
 
 	Observable& operator=(const Observable&) = delete;
 	Observable& operator=(Observable&& other) noexcept
 	{
-		m_repo = std::move(other.m_repo);
-		m_dirty = true;
-		other.m_dirty = true;
+		if (this != &other) {
+			release();
+			m_count = other.m_count;
+			if (m_count == OVERFLOWED)
+				m_overflow = other.m_overflow;
+			else {
+				for (unsigned int i = 0; i < m_count; i++)
+					m_inline[i] = other.m_inline[i];
+			}
+			other.m_count = 0;
+
+			//A held back signal follows the listeners
+			if (other.m_pending) {
+				ObservableBatch::current().move(other.m_pending, this);
+				m_pending = other.m_pending;
+				other.m_pending = 0;
+			}
+		}
 		return *this;
 	}
 
 	void addListener(IListener<T>& l)
 	{
-		m_dirty = m_repo.insert(&l).second;
+		if (m_count != OVERFLOWED) {
+			for (unsigned int i = 0; i < m_count; i++) {
+				if (m_inline[i] == &l)
+					return;
+			}
+			if (m_count < INLINE) {
+				m_inline[m_count++] = &l;
+				return;
+			}
+			else
+				overflow();
+		}
+
+		Overflow& o = *m_overflow;
+		if (o.slots.try_emplace(&l, static_cast<unsigned int>(o.listeners.size())).second) {
+			o.listeners.push_back(&l);
+			o.dirty = true;
+		}
 	}
 	void removeListener(IListener<T>& l)
 	{
-		m_dirty = m_repo.erase(&l);
+		//Keep the order while we are in place, it's no more work
+		if (m_count != OVERFLOWED) {
+			for (unsigned int i = 0; i < m_count; i++) {
+				if (m_inline[i] == &l) {
+					for (unsigned int j = i + 1; j < m_count; j++)
+						m_inline[j - 1] = m_inline[j];
+					m_count--;
+					return;
+				}
+			}
+		}
+		else {
+			Overflow& o = *m_overflow;
+			if (auto it = o.slots.find(&l); it != o.slots.end()) {
+				//Move the last listener into the vacated slot
+				unsigned int slot = it->second;
+				o.slots.erase(it);
+				IListener<T>* last = o.listeners.back();
+				o.listeners.pop_back();
+				if (last != &l) {
+					o.listeners[slot] = last;
+					o.slots[last] = slot;
+				}
+				o.dirty = true;
+			}
+		}
 	}
 
 	//Postpone this change. It may or may not be a good idea.
 	//[[nodiscard]] std::unique_ptr<Unsubscriber> addListener(IListener<T>&) {}
 
+	//Listeners added or removed by a listener take effect from the next signal
 	void signal(const Event<T>& e)
 	{
-		if (m_dirty) {
-			m_work.clear();
-			m_work.insert(m_work.begin(), m_repo.begin(), m_repo.end());
-			m_dirty = false;
+		if (m_count != OVERFLOWED) {
+			IListener<T>* work[INLINE];
+			unsigned int count = m_count;
+			for (unsigned int i = 0; i < count; i++)
+				work[i] = m_inline[i];
+
+			for (unsigned int i = 0; i < count; i++) {
+				assert(work[i]);
+				work[i]->receive(e, *this);
+			}
 		}
+		else {
+			if (m_overflow->dirty) {
+				m_overflow->work = m_overflow->listeners;
+				m_overflow->dirty = false;
+			}
 
-		for (IListener<T>* l : m_work) {
-			assert(l);
-			l->receive(e, *this);
+			for (IListener<T>* l : m_overflow->work) {
+				assert(l);
+				l->receive(e, *this);
+			}
 		}
 	}
 
 protected:
-	std::set<IListener<T>*> m_repo;
-	std::vector<IListener<T>*> m_work;
-	bool m_dirty{ false };
+	//Signals e now, or, while an ObservableBatch is active, once when it ends. Repeated calls during 
+	//the batch are collapsed into one signal of LatestEvent<T>, so T must specialise it.
+	//before may point to the state we were in before this change, to pass on to LatestEvent if
+	//this is the first change of the batch (only if it fits, see ObservableBatch::can_hold).
+	template<typename S = char>
+	void signalLatest(const Event<T>& e, const S* before = nullptr)
+	{
+		static_assert(ObservableBatch::can_hold<S>);
+		if (ObservableBatch::active() && m_count != 0) {
+			if (!m_pending)
+				m_pending = ObservableBatch::current().add(this, &Observable<T>::deliver, before, sizeof(S));
+		}
+		else
+			signal(e);
+	}
+
+private:
+	static void deliver(void* p, const void* before)
+	{
+		Observable<T>& o = *static_cast<Observable<T>*>(p);
+		o.m_pending = 0;
+		o.signal(LatestEvent<T>::get(static_cast<const T&>(o), before));
+	}
+
+	//Move our listeners to the heap (or the current ObservableArena)
+	void overflow()
+	{
+		assert(m_count == INLINE);
+
+		std::shared_ptr<std::pmr::memory_resource> owner = ObservableArena::current();
+		std::pmr::memory_resource* resource = owner ? owner.get() : std::pmr::get_default_resource();
+		Overflow* o = new (resource->allocate(sizeof(Overflow), alignof(Overflow))) Overflow(std::move(owner), resource);
+		o->listeners.assign(m_inline, m_inline + m_count);
+		for (unsigned int i = 0; i < m_count; i++)
+			o->slots.emplace(m_inline[i], i);
+
+		m_overflow = o;
+		m_count = OVERFLOWED;
+	}
+
+	void release() noexcept
+	{
+		//Nobody will hear it now
+		if (m_pending) {
+			ObservableBatch::current().drop(m_pending);
+			m_pending = 0;
+		}
+		if (m_count == OVERFLOWED) {
+			//The arena must survive until we have given the memory back
+			std::shared_ptr<std::pmr::memory_resource> owner = std::move(m_overflow->owner);
+			std::pmr::memory_resource* resource = m_overflow->listeners.get_allocator().resource();
+			m_overflow->~Overflow();
+			resource->deallocate(m_overflow, sizeof(Overflow), alignof(Overflow));
+		}
+		m_count = 0;
+	}
+
+private:
+	union
+	{
+		IListener<T>* m_inline[INLINE];
+		Overflow* m_overflow;
+	};
+	//Number of listeners in m_inline, or OVERFLOWED
+	unsigned int m_count{ 0 };
+	//Our entry in the active ObservableBatch, or 0
+	unsigned int m_pending{ 0 };
 };
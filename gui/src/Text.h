@@ -37,6 +37,7 @@ namespace gui
 		virtual Floats<2> getSizeHint() const override;
 
 		void setWrap(bool wrap = true) { m_wrap = wrap; }
+		void setText(const std::string& text) { m_text = text; }
 
 	private:
 		std::string m_text;
@@ -67,7 +68,7 @@ namespace gui
 
 		virtual void frame(FrameDrawer& fd) override
 		{
-			std::string s = util::property_traits<PropertyType>::get(m_property);
+			const std::string& s = util::property_traits<PropertyType>::get(m_property);
 
 			backend::text(s);
 		}
@@ -44,13 +44,14 @@ namespace gui
 
 		virtual void frame(FrameDrawer& fd) override
 		{
-			std::string s = util::property_traits<PropertyType>::get(m_property);
+			//The backend edits in place, so we need a copy. Reusing ours saves an allocation per frame.
+			m_buffer = util::property_traits<PropertyType>::get(m_property);
 
-			unsigned int result = backend::TextInput(m_label[0], &s);
+			unsigned int result = backend::TextInput(m_label[0], &m_buffer);
 			if (result & WIDGET_ACTIVATED)
-				m_tmp = s;
+				m_tmp = m_buffer;
 			if (result & WIDGET_RELEASED)
-				asyncInvoke<SetProperty<std::string, PropertyType>>(m_property, s, m_tmp, true);
+				asyncInvoke<SetProperty<std::string, PropertyType>>(m_property, m_buffer, m_tmp, true);
 		}
 
 		virtual Floats<2> getSizeHint() const override { return { -1.0f, getDefaultHeight() }; }
@@ -59,6 +60,7 @@ namespace gui
 		PropertyType m_property;
 		UniqueLabel<1> m_label;
 		std::string m_tmp;
+		std::string m_buffer;
 	};
 }
 
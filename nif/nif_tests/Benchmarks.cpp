@@ -0,0 +1,413 @@
+//Copyright 2021 Jonas Gernandt
+//
+//This file is part of SVFX Editor, a program for creating visual effects
+//in the NetImmerse format.
+//
+//SVFX Editor is free software: you can redistribute it and/or modify
+//it under the terms of the GNU General Public License as published by
+//the Free Software Foundation, either version 3 of the License, or
+//(at your option) any later version.
+//
+//SVFX Editor is distributed in the hope that it will be useful,
+//but WITHOUT ANY WARRANTY; without even the implied warranty of
+//MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//GNU General Public License for more details.
+//
+//You should have received a copy of the GNU General Public License
+//along with SVFX Editor. If not, see <https://www.gnu.org/licenses/>.
+
+#include "pch.h"
+#include "CppUnitTest.h"
+#include "Timer.h"
+
+#include <algorithm>
+#include <random>
+#include <thread>
+
+#ifdef _DEBUG
+#include <crtdbg.h>
+#endif
+
+//Timings are written to the test output. They are for comparing builds, they don't fail.
+namespace benchmarks
+{
+	using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+	using namespace nif;
+
+	template<typename period_t>
+	void log(const std::string& what, long long time)
+	{
+		std::string unit = std::is_same<period_t, std::milli>::value ? " ms" : " ns";
+		Logger::WriteMessage((what + ": " + std::to_string(time) + unit + "\n").c_str());
+	}
+
+	void logBytes(const std::string& what, long long bytes)
+	{
+		Logger::WriteMessage((what + ": " + std::to_string(bytes) + " bytes\n").c_str());
+	}
+
+	void logCount(const std::string& what, long long count)
+	{
+		Logger::WriteMessage((what + ": " + std::to_string(count) + "\n").c_str());
+	}
+
+	TEST_CLASS(FileBenchmarks)
+	{
+	public:
+		constexpr static int NODES = 5000;
+
+		//Save and load a graph of about 10k blocks
+		TEST_METHOD(LoadSave10k)
+		{
+			std::filesystem::path path = std::filesystem::temp_directory_path() / "svfx_benchmark.nif";
+
+			{
+				File file{ File::Version::SKYRIM_SE };
+				makeGraph(file);
+
+				Timer<long long, std::milli> timer;
+				file.write(path);
+				log<std::milli>("Save, all objects changed", timer.elapsed());
+
+				timer.reset();
+				file.write(path);
+				log<std::milli>("Save, no objects changed", timer.elapsed());
+			}
+
+			Timer<long long, std::milli> timer;
+			auto file = std::make_unique<File>(path);
+			log<std::milli>("Load", timer.elapsed());
+
+			Assert::IsTrue(file->getRoot()->children.size() == NODES);
+
+			timer.reset();
+			file.reset();
+			log<std::milli>("Close", timer.elapsed());
+
+			std::filesystem::remove(path);
+		}
+
+		//Load a graph of about 10k blocks on one thread and up to one per hardware thread
+		TEST_METHOD(LoadScaling10k)
+		{
+			std::filesystem::path path = std::filesystem::temp_directory_path() / "svfx_benchmark.nif";
+			{
+				File file{ File::Version::SKYRIM_SE };
+				makeGraph(file);
+				file.write(path);
+			}
+
+			unsigned int maxThreads = std::max(std::thread::hardware_concurrency(), 1u);
+			for (unsigned int threads = 1;; threads = std::min(2 * threads, maxThreads)) {
+				Timer<long long, std::milli> timer;
+				File file(path, threads);
+				log<std::milli>("Load, " + std::to_string(threads) + " threads", timer.elapsed());
+
+				Assert::IsTrue(file.getRoot()->children.size() == NODES);
+
+				if (threads == maxThreads)
+					break;
+			}
+
+			std::filesystem::remove(path);
+		}
+
+		//Look up objects in both directions through the File's index
+		TEST_METHOD(IndexLookup10k)
+		{
+			constexpr int ROUNDS = 100;
+
+			File file{ File::Version::SKYRIM_SE };
+			makeGraph(file);
+
+			std::vector<NiAVObject*> objects;
+			for (auto&& child : file.getRoot()->children)
+				objects.push_back(child.get());
+
+			Timer<> timer;
+			for (int i = 0; i < ROUNDS; i++) {
+				for (NiAVObject* object : objects) {
+					auto native = file.getNative<NiAVObject>(object);
+					auto shared = file.get<NiAVObject>(native);
+					Assert::IsTrue(shared.get() == object);
+				}
+			}
+			log<std::nano>("Lookup pair, per object", timer.elapsed() / (ROUNDS * static_cast<long long>(objects.size())));
+		}
+
+		//Files per second loaded by load_many, from one thread and up to one per hardware thread
+		TEST_METHOD(LoadManyScaling)
+		{
+			constexpr int FILES = 200;
+
+			std::vector<std::filesystem::path> paths;
+			{
+				File file{ File::Version::SKYRIM_SE };
+				for (int i = 0; i < 100; i++) {
+					auto node = file.create<NiNode>();
+					node->extraData.add(file.create<NiStringExtraData>());
+					file.getRoot()->children.add(node);
+				}
+				for (int i = 0; i < FILES; i++) {
+					paths.push_back(std::filesystem::temp_directory_path() / ("svfx_benchmark_" + std::to_string(i) + ".nif"));
+					file.write(paths.back());
+				}
+			}
+
+			unsigned int maxThreads = std::max(std::thread::hardware_concurrency(), 1u);
+			for (unsigned int threads = 1;; threads = std::min(2 * threads, maxThreads)) {
+				Timer<long long, std::milli> timer;
+				auto results = load_many(paths, threads);
+				long long ms = std::max(timer.elapsed(), 1LL);
+
+				for (auto&& result : results)
+					Assert::IsTrue(result.file != nullptr);
+
+				log<std::milli>("load_many, " + std::to_string(threads) + " threads, "
+					+ std::to_string(FILES * 1000 / ms) + " files/s", ms);
+
+				if (threads == maxThreads)
+					break;
+			}
+
+			for (auto&& path : paths)
+				std::filesystem::remove(path);
+		}
+
+		//Headers read per second by probe
+		TEST_METHOD(ProbeThroughput)
+		{
+			constexpr int FILES = 100;
+			constexpr int ROUNDS = 20;
+
+			std::vector<std::filesystem::path> paths;
+			{
+				File file{ File::Version::SKYRIM_SE };
+				makeGraph(file);
+				for (int i = 0; i < FILES; i++) {
+					paths.push_back(std::filesystem::temp_directory_path() / ("svfx_probe_" + std::to_string(i) + ".nif"));
+					file.write(paths.back());
+				}
+			}
+
+			Timer<long long, std::milli> timer;
+			for (int i = 0; i < ROUNDS; i++) {
+				for (auto&& path : paths) {
+					auto result = probe(path);
+					Assert::IsTrue(result.blockCount == 2 * NODES + 1);
+				}
+			}
+			long long ms = std::max(timer.elapsed(), 1LL);
+			log<std::milli>("probe, " + std::to_string(ROUNDS * FILES * 1000LL / ms) + " files/s", ms);
+
+			for (auto&& path : paths)
+				std::filesystem::remove(path);
+		}
+
+		//Memory per key of a loaded NiFloatData.
+		//The heap is only tracked in debug builds, release builds just report the column data per key.
+		TEST_METHOD(KeyMemory)
+		{
+			constexpr int KEYS = 10000;
+
+			logBytes("KeyTable<float> data per key", sizeof(KeyTable<float>::Row));
+
+#ifdef _DEBUG
+			std::filesystem::path path = std::filesystem::temp_directory_path() / "svfx_benchmark_keys.nif";
+
+			//Heap in use by a loaded file with keys keys
+			auto loadedSize = [&path](int keys)
+			{
+				{
+					File file{ File::Version::SKYRIM_SE };
+					auto ctlr = file.create<NiSingleInterpController>();
+					auto iplr = file.create<NiFloatInterpolator>();
+					auto data = file.create<NiFloatData>();
+					data->keys.resize(keys);
+					for (int i = 0; i < keys; i++)
+						data->keys.set<KeyColumn::TIME>(i, static_cast<float>(i));
+					iplr->data.assign(data);
+					ctlr->interpolator.assign(iplr);
+					file.getRoot()->controllers.insert(0, ctlr);
+					file.write(path);
+				}
+
+				_CrtMemState before;
+				_CrtMemCheckpoint(&before);
+
+				File file(path);
+
+				_CrtMemState after;
+				_CrtMemCheckpoint(&after);
+				_CrtMemState diff;
+				_CrtMemDifference(&diff, &before, &after);
+				return static_cast<long long>(diff.lSizes[_NORMAL_BLOCK] + diff.lSizes[_CLIENT_BLOCK]);
+			};
+
+			long long bytes = loadedSize(KEYS) - loadedSize(0);
+			logBytes("Heap per loaded key (including Niflib's)", bytes / KEYS);
+
+			std::filesystem::remove(path);
+#endif
+		}
+
+		//Sync passes over a 10k object table, sent through receive and through the dispatch tables
+		TEST_METHOD(Dispatch10k)
+		{
+			constexpr int ROUNDS = 20;
+
+			File file{ File::Version::SKYRIM_SE };
+			makeGraph(file);
+			auto&& table = file.objects();
+			long long visits = ROUNDS * static_cast<long long>(table.size());
+
+			for (Dispatch mode : { Dispatch::VIRTUAL, Dispatch::TABLE }) {
+				std::string name = mode == Dispatch::TABLE ? "table" : "virtual";
+
+				//Reading is not a change, so it must not reach the journal (as in make_ni)
+				NonForwardingReadSyncer reader(file);
+				reader.setDispatch(mode);
+				Timer<> timer;
+				{
+					ChangeJournal::Suspension suspension(file.journal());
+					ChangeBatch batch(ChangeBatch::Isolated{});
+					for (int i = 0; i < ROUNDS; i++)
+						table.traverse(reader);
+				}
+				log<std::nano>("Read sync, " + name + " dispatch, per object", timer.elapsed() / visits);
+
+				NonForwardingWriteSyncer writer(file);
+				writer.setDispatch(mode);
+				timer.reset();
+				for (int i = 0; i < ROUNDS; i++)
+					table.traverse(writer);
+				log<std::nano>("Write sync, " + name + " dispatch, per object", timer.elapsed() / visits);
+
+				//Recursion through the Forwarders, like a load or a full write
+				ForwardingWriteSyncer forwarder(file);
+				forwarder.setDispatch(mode);
+				timer.reset();
+				for (int i = 0; i < ROUNDS; i++)
+					file.getRoot()->dispatch(forwarder);
+				log<std::nano>("Forwarding write sync, " + name + " dispatch, per object", timer.elapsed() / visits);
+			}
+		}
+
+	private:
+		//NODES nodes under the root, each with one extra data
+		static void makeGraph(File& file)
+		{
+			for (int i = 0; i < NODES; i++) {
+				auto node = file.create<NiNode>();
+				auto data = file.create<NiStringExtraData>();
+				data->value.set(std::to_string(i));
+				node->extraData.add(data);
+				file.getRoot()->children.add(node);
+			}
+		}
+	};
+
+	TEST_CLASS(FieldBenchmarks)
+	{
+	public:
+		//Indexed access to a 10k element List, in the patterns our listeners use
+		TEST_METHOD(ListIndexing)
+		{
+			constexpr int SIZE = 10000;
+			constexpr int ROUNDS = 10;
+
+			List<Key<float>> list;
+			list.resize(SIZE);
+
+			Timer<> timer;
+			float sum = 0.0f;
+			for (int r = 0; r < ROUNDS; r++) {
+				for (int i = 0; i < SIZE; i++)
+					sum += list.at(i).time.get();
+			}
+			log<std::nano>("List sequential at, per access", timer.elapsed() / (ROUNDS * SIZE));
+
+			std::mt19937 rng;
+			std::uniform_int_distribution<int> D(0, SIZE - 1);
+			std::vector<int> indices(ROUNDS * SIZE);
+			for (int& i : indices)
+				i = D(rng);
+
+			timer.reset();
+			for (int i : indices)
+				sum += list.at(i).time.get();
+			log<std::nano>("List random at, per access", timer.elapsed() / static_cast<long long>(indices.size()));
+
+			timer.reset();
+			for (int r = 0; r < ROUNDS * 100; r++) {
+				list.insert(SIZE / 2);
+				list.erase(SIZE / 2);
+			}
+			log<std::nano>("List insert/erase in the middle, per pair", timer.elapsed() / (ROUNDS * 100));
+
+			Assert::IsTrue(list.size() == SIZE && sum == 0.0f);
+		}
+
+		//Reading a vector and a string Property, the way widgets and write syncers do every frame.
+		//Allocations are only counted in debug builds.
+		TEST_METHOD(PropertyReads)
+		{
+			constexpr int READS = 10000;
+
+			Property<std::vector<float>> scales;
+			scales.set(std::vector<float>(16, 1.0f));
+			Property<std::string> name;
+			name.set("A name that is too long for the small string buffer");
+
+			size_t total = 0;
+
+			Timer<> timer;
+			long long allocs = countAllocations([&]()
+				{
+					for (int i = 0; i < READS; i++)
+						total += scales.get().size() + name.get().size();
+				});
+			log<std::nano>("Property get, per read pair", timer.elapsed() / READS);
+			logCount("Property get, allocations", allocs);
+
+			timer.reset();
+			allocs = countAllocations([&]()
+				{
+					for (int i = 0; i < READS; i++)
+						total += scales.view().size() + name.view().size();
+				});
+			log<std::nano>("Property view, per read pair", timer.elapsed() / READS);
+			logCount("Property view, allocations", allocs);
+
+			Assert::IsTrue(total == 2 * READS * (16 + name.view().size()));
+		}
+
+	private:
+#ifdef _DEBUG
+		inline static long long s_allocs = 0;
+
+		static int allocHook(int type, void*, size_t, int, long, const unsigned char*, int)
+		{
+			if (type == _HOOK_ALLOC)
+				s_allocs++;
+			return TRUE;
+		}
+#endif
+
+		//Number of heap allocations made by f (0 in release builds)
+		template<typename Fcn>
+		static long long countAllocations(Fcn&& f)
+		{
+#ifdef _DEBUG
+			s_allocs = 0;
+			_CRT_ALLOC_HOOK previous = _CrtSetAllocHook(&allocHook);
+			f();
+			_CrtSetAllocHook(previous);
+			return s_allocs;
+#else
+			f();
+			return 0;
+#endif
+		}
+	};
+}
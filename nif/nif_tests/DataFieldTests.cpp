@@ -344,6 +344,87 @@ namespace fields
 		}
 	};
 
+	TEST_CLASS(KeyTable)
+	{
+	public:
+
+		//Columns should stay aligned through every change, and listeners should get one event per change
+		TEST_METHOD(KeyTableTest)
+		{
+			using Event_t = Event<nif::KeyTable<float>>;
+
+			struct Listener : KeyTableListener<float>
+			{
+				virtual void receive(const Event_t& e, Observable<nif::KeyTable<float>>& o) override
+				{
+					events.push_back(e);
+				}
+
+				std::vector<Event_t> events;
+			};
+
+			nif::KeyTable<float> keys;
+			Listener lsnr;
+			keys.addListener(lsnr);
+
+			keys.resize(4);
+			Assert::IsTrue(keys.size() == 4);
+			Assert::IsTrue(lsnr.events.size() == 1);
+			Assert::IsTrue(lsnr.events.back().type == Event_t::INSERT);
+			Assert::IsTrue(lsnr.events.back().pos1 == 0 && lsnr.events.back().count == 4);
+
+			keys.assign<KeyColumn::TIME>(0, { 0.0f, 1.0f, 2.0f, 3.0f });
+			keys.assign<KeyColumn::VALUE>(0, { 10.0f, 11.0f, 12.0f, 13.0f });
+			Assert::IsTrue(lsnr.events.size() == 3);
+			Assert::IsTrue(lsnr.events.back().type == Event_t::SET && lsnr.events.back().column == KeyColumn::VALUE);
+			Assert::IsTrue(lsnr.events.back().pos1 == 0 && lsnr.events.back().count == 4);
+			Assert::IsTrue((keys.times() == std::vector<float>{ 0.0f, 1.0f, 2.0f, 3.0f }));
+
+			//Setting the current value is not a change
+			keys.set<KeyColumn::BIAS>(2, 0.0f);
+			Assert::IsTrue(lsnr.events.size() == 3);
+			keys.set<KeyColumn::BIAS>(2, 0.5f);
+			Assert::IsTrue(lsnr.events.size() == 4);
+			Assert::IsTrue(lsnr.events.back().column == KeyColumn::BIAS && lsnr.events.back().pos1 == 2);
+			Assert::IsTrue(keys.get<KeyColumn::BIAS>(2) == 0.5f);
+
+			//Rows move with all their columns
+			keys.move(2, 0);
+			Assert::IsTrue((keys.times() == std::vector<float>{ 2.0f, 0.0f, 1.0f, 3.0f }));
+			Assert::IsTrue((keys.values() == std::vector<float>{ 12.0f, 10.0f, 11.0f, 13.0f }));
+			Assert::IsTrue(keys.get<KeyColumn::BIAS>(0) == 0.5f && keys.get<KeyColumn::BIAS>(2) == 0.0f);
+			keys.move(0, 3);
+			Assert::IsTrue((keys.times() == std::vector<float>{ 0.0f, 1.0f, 3.0f, 2.0f }));
+			Assert::IsTrue(lsnr.events.back().type == Event_t::MOVE);
+			Assert::IsTrue(lsnr.events.back().pos1 == 0 && lsnr.events.back().pos2 == 3);
+
+			//A row taken out can be put back as it was
+			auto row = keys.row(3);
+			keys.erase(3);
+			Assert::IsTrue(keys.size() == 3);
+			Assert::IsTrue(lsnr.events.back().type == Event_t::ERASE && lsnr.events.back().pos1 == 3);
+			keys.insert(1, row);
+			Assert::IsTrue(keys.size() == 4);
+			Assert::IsTrue(lsnr.events.back().type == Event_t::INSERT && lsnr.events.back().count == 1);
+			Assert::IsTrue(keys.get<KeyColumn::TIME>(1) == 2.0f && keys.get<KeyColumn::VALUE>(1) == 12.0f);
+			Assert::IsTrue(keys.get<KeyColumn::BIAS>(1) == 0.5f);
+
+			keys.insert(2, 3);
+			Assert::IsTrue(keys.size() == 7);
+			Assert::IsTrue((keys.times() == std::vector<float>{ 0.0f, 2.0f, 0.0f, 0.0f, 0.0f, 1.0f, 3.0f }));
+			keys.erase(2, 3);
+			Assert::IsTrue((keys.values() == std::vector<float>{ 10.0f, 12.0f, 11.0f, 13.0f }));
+			Assert::IsTrue(lsnr.events.back().type == Event_t::ERASE && lsnr.events.back().count == 3);
+
+			size_t n = lsnr.events.size();
+			keys.clear();
+			Assert::IsTrue(keys.empty());
+			Assert::IsTrue(lsnr.events.size() == n + 1);
+
+			keys.removeListener(lsnr);
+		}
+	};
+
 	TEST_CLASS(List)
 	{
 	public:
@@ -534,6 +615,128 @@ namespace fields
 			Assert::IsTrue(lsnr.wasErased(0));
 			Assert::IsFalse(lsnr.wasErased());
 		}
+
+		TEST_METHOD(Iterators)
+		{
+			using iterator = nif::List<Key<float>>::iterator;
+			using const_iterator = nif::List<Key<float>>::const_iterator;
+			static_assert(std::is_convertible_v<iterator, const_iterator>);
+			static_assert(!std::is_constructible_v<iterator, const_iterator>);
+			static_assert(std::is_same_v<std::iterator_traits<iterator>::iterator_category, std::random_access_iterator_tag>);
+
+			nif::List<Key<float>> list;
+			list.insert(0, 5);
+			for (int i = 0; i < 5; i++)
+				list.at(i).time.set(static_cast<float>(i));
+
+			iterator begin = list.begin();
+			iterator end = list.end();
+			const_iterator cbegin = begin;
+			const nif::List<Key<float>>& clist = list;
+			Assert::IsTrue(cbegin == clist.begin());
+			Assert::IsTrue(std::distance(begin, end) == 5);
+			Assert::IsTrue(end - begin == 5);
+
+			//arithmetic
+			Assert::IsTrue(&*(begin + 2) == &list.at(2));
+			Assert::IsTrue(&*(2 + begin) == &list.at(2));
+			Assert::IsTrue(&*(end - 1) == &list.back());
+			Assert::IsTrue(&begin[3] == &list.at(3));
+			Assert::IsTrue((begin + 4)->time.get() == 4.0f);
+
+			iterator it = begin;
+			it += 3;
+			Assert::IsTrue(&*it == &list.at(3));
+			it -= 2;
+			Assert::IsTrue(&*it == &list.at(1));
+			Assert::IsTrue(&*it++ == &list.at(1));
+			Assert::IsTrue(&*it-- == &list.at(2));
+			Assert::IsTrue(&*++it == &list.at(2));
+			Assert::IsTrue(&*--it == &list.at(1));
+
+			//comparison
+			Assert::IsTrue(begin < end);
+			Assert::IsTrue(end > begin);
+			Assert::IsTrue(begin <= begin);
+			Assert::IsTrue(begin <= end);
+			Assert::IsTrue(end >= end);
+			Assert::IsTrue(end >= begin);
+			Assert::IsFalse(begin > end);
+			Assert::IsFalse(end <= begin);
+			Assert::IsFalse(begin >= end);
+
+			//algorithms
+			auto found = std::lower_bound(list.begin(), list.end(), 3.0f,
+				[](const Key<float>& key, float t) { return key.time.get() < t; });
+			Assert::IsTrue(found - list.begin() == 3);
+		}
+
+		TEST_METHOD(Ranges)
+		{
+			struct Listener : ListListener<Key<float>>
+			{
+				virtual void onInsertRange(int pos, int count) override
+				{
+					m_inserted.push_back({ pos, count });
+				}
+				virtual void onEraseRange(int pos, int count) override
+				{
+					m_erased.push_back({ pos, count });
+				}
+
+				std::deque<std::pair<int, int>> m_inserted;
+				std::deque<std::pair<int, int>> m_erased;
+			};
+
+			Listener lsnr;
+			nif::List<Key<float>> list;
+			list.insert(0, 2);
+			Key<float>* first = &list.front();
+			Key<float>* last = &list.back();
+
+			list.addListener(lsnr);
+
+			//insert a range in the middle
+			list.insert(1, 3);
+			Assert::IsTrue(list.size() == 5);
+			Assert::IsTrue(lsnr.m_inserted.size() == 1);
+			Assert::IsTrue(lsnr.m_inserted.front() == std::pair<int, int>(1, 3));
+			Assert::IsTrue(lsnr.m_erased.empty());
+			lsnr.m_inserted.clear();
+
+			//existing elements should not have moved
+			Assert::IsTrue(&list.at(0) == first);
+			Assert::IsTrue(&list.at(4) == last);
+			Key<float>* middle = &list.at(3);
+
+			//empty ranges should not signal
+			list.insert(2, 0);
+			list.erase(2, 0);
+			Assert::IsTrue(list.size() == 5);
+			Assert::IsTrue(lsnr.m_inserted.empty());
+			Assert::IsTrue(lsnr.m_erased.empty());
+
+			//erase a range
+			list.erase(1, 2);
+			Assert::IsTrue(list.size() == 3);
+			Assert::IsTrue(lsnr.m_erased.size() == 1);
+			Assert::IsTrue(lsnr.m_erased.front() == std::pair<int, int>(1, 2));
+			Assert::IsTrue(lsnr.m_inserted.empty());
+			lsnr.m_erased.clear();
+
+			Assert::IsTrue(&list.at(0) == first);
+			Assert::IsTrue(&list.at(1) == middle);
+			Assert::IsTrue(&list.at(2) == last);
+
+			//erase to the end
+			list.erase(1, 2);
+			Assert::IsTrue(list.size() == 1);
+			Assert::IsTrue(lsnr.m_erased.size() == 1);
+			Assert::IsTrue(lsnr.m_erased.front() == std::pair<int, int>(1, 2));
+			Assert::IsTrue(&list.front() == first);
+
+			list.removeListener(lsnr);
+		}
 	};
 
 	TEST_CLASS(Property)
@@ -628,6 +831,115 @@ namespace fields
 			prop.set(val);
 			Assert::IsFalse(lsnr.wasSet(val));
 		}
+
+		//view should refer to the current value, not a copy of it
+		TEST_METHOD(View)
+		{
+			nif::Property<std::string> prop;
+			const std::string& view = prop.view();
+			Assert::IsTrue(view.empty());
+
+			prop.set("value");
+			Assert::IsTrue(&prop.view() == &view);
+			Assert::IsTrue(view == "value");
+		}
+
+		//Vectors are held as shared snapshots, that are never modified
+		TEST_METHOD(Snapshot)
+		{
+			struct Counter : PropertyListener<std::vector<float>>
+			{
+				virtual void onSet(const std::vector<float>&) override { count++; }
+				int count{ 0 };
+			};
+
+			nif::Property<std::vector<float>> prop;
+			Counter c;
+			prop.addListener(c);
+
+			prop.set({ 1.0f, 2.0f });
+			auto first = prop.snapshot();
+			Assert::IsTrue(&prop.view() == first.get());
+			Assert::IsTrue(c.count == 1);
+
+			prop.set({ 3.0f });
+			auto second = prop.snapshot();
+			Assert::IsTrue(c.count == 2);
+			Assert::IsTrue((*first == std::vector<float>{ 1.0f, 2.0f }));
+
+			//Setting a snapshot shares it
+			prop.set(first);
+			Assert::IsTrue(c.count == 3);
+			Assert::IsTrue(&prop.view() == first.get());
+
+			//The same snapshot is not a change, an equal copy is not either
+			prop.set(first);
+			prop.set(std::vector<float>{ 1.0f, 2.0f });
+			Assert::IsTrue(c.count == 3);
+			Assert::IsTrue(prop.snapshot() == first);
+
+			//A moved-from Property still has a value
+			nif::Property<std::vector<float>> moved(std::move(prop));
+			Assert::IsTrue(moved.snapshot() == first);
+			Assert::IsTrue(prop.view().empty());
+
+			moved.removeListener(c);
+		}
+
+		//A batch should deliver one signal per Property, with its final value, when the outermost batch ends
+		TEST_METHOD(Batch)
+		{
+			struct Counter : PropertyListener<float>
+			{
+				virtual void onSet(const float& f) override
+				{
+					count++;
+					last = f;
+				}
+				int count{ 0 };
+				float last{ 0.0f };
+			};
+
+			nif::Property<float> p1;
+			nif::Property<float> p2;
+			Counter c1;
+			Counter c2;
+			p1.addListener(c1);
+			p2.addListener(c2);
+			{
+				ChangeBatch batch;
+				for (int i = 1; i <= 500; i++)
+					p1.set(static_cast<float>(i));
+				{
+					ChangeBatch inner;
+					p2.set(1.0f);
+				}
+				Assert::IsTrue(c1.count == 0 && c2.count == 0);
+			}
+			Assert::IsTrue(c1.count == 1 && c1.last == 500.0f);
+			Assert::IsTrue(c2.count == 1 && c2.last == 1.0f);
+
+			//Pending signals follow a moved Property, and are dropped with a destroyed one
+			c1.count = 0;
+			nif::Property<float> p3;
+			{
+				ChangeBatch batch;
+				p1.set(1.0f);
+				p3 = std::move(p1);
+				p3.set(2.0f);
+
+				auto p4 = std::make_unique<nif::Property<float>>();
+				p4->addListener(c2);
+				p4->set(1.0f);
+				p4.reset();
+			}
+			Assert::IsTrue(c1.count == 1 && c1.last == 2.0f);
+			Assert::IsTrue(c2.count == 1);
+
+			//Without a batch, we signal immediately
+			p3.set(3.0f);
+			Assert::IsTrue(c1.count == 2 && c1.last == 3.0f);
+		}
 	};
 
 	TEST_CLASS(Sequence)
@@ -800,6 +1112,37 @@ namespace fields
 			Assert::IsTrue(lsnr.wasErased(0));
 			Assert::IsFalse(lsnr.wasErased());
 		}
+
+		//Positions should stay correct as elements shift around
+		TEST_METHOD(Positions)
+		{
+			constexpr int N = 200;
+
+			nif::Sequence<NiObject> seq;
+			std::vector<std::shared_ptr<NiObject>> objs;
+			for (int i = 0; i < N; i++) {
+				objs.push_back(std::make_shared<NiObject>());
+				seq.insert(0, objs.back());
+			}
+			for (int i = 0; i < N; i++)
+				Assert::IsTrue(seq.find(objs[i].get()) == N - 1 - i);
+
+			//Duplicates are rejected wherever they are
+			Assert::IsTrue(seq.insert(0, objs[0]) == N - 1);
+			Assert::IsTrue(seq.insert(0, std::vector<std::shared_ptr<NiObject>>{ objs[1], objs[1] }) == 0);
+			Assert::IsTrue(seq.size() == N);
+
+			seq.erase(0, N / 2);
+			for (int i = 0; i < N / 2; i++)
+				Assert::IsTrue(seq.find(objs[i].get()) == N / 2 - 1 - i);
+			for (int i = N / 2; i < N; i++)
+				Assert::IsTrue(seq.find(objs[i].get()) == -1);
+
+			seq.insert(N / 4, std::vector<std::shared_ptr<NiObject>>{ objs[N - 1], objs[N - 2] });
+			Assert::IsTrue(seq.find(objs[N - 1].get()) == N / 4);
+			Assert::IsTrue(seq.find(objs[N - 2].get()) == N / 4 + 1);
+			Assert::IsTrue(seq.find(objs[0].get()) == N / 2 + 1);
+		}
 	};
 
 	TEST_CLASS(Set)
@@ -1270,5 +1613,50 @@ namespace fields
 			Assert::IsTrue(lsnr.wasErased(0));
 			Assert::IsFalse(lsnr.wasErased());
 		}
+
+		//Bulk changes should signal one range, and keep the elements around it in place
+		TEST_METHOD(ranges)
+		{
+			struct RangeListener : VectorListener<Key<float>>
+			{
+				virtual void onInsert(int) override { singles++; }
+				virtual void onErase(int) override { singles++; }
+				virtual void onInsertRange(int pos, int count) override { ranges.push_back({ pos, count }); }
+				virtual void onEraseRange(int pos, int count) override { ranges.push_back({ pos, -count }); }
+
+				int singles{ 0 };
+				std::vector<std::pair<int, int>> ranges;
+			};
+
+			nif::Vector<Key<float>> vec;
+			RangeListener lsnr;
+			vec.addListener(lsnr);
+
+			vec.resize(500);
+			Assert::IsTrue(vec.size() == 500);
+			for (int i = 0; i < 500; i++)
+				vec.at(i).time.set(static_cast<float>(i));
+
+			vec.insert(100, 50);
+			Assert::IsTrue(vec.size() == 550);
+			Assert::IsTrue(vec.at(99).time.get() == 99.0f);
+			Assert::IsTrue(vec.at(100).time.get() == 0.0f && vec.at(149).time.get() == 0.0f);
+			Assert::IsTrue(vec.at(150).time.get() == 100.0f);
+
+			vec.erase(100, 50);
+			Assert::IsTrue(vec.size() == 500);
+			Assert::IsTrue(vec.at(100).time.get() == 100.0f);
+
+			vec.clear();
+			Assert::IsTrue(vec.size() == 0);
+
+			Assert::IsTrue(lsnr.singles == 0);
+			Assert::IsTrue((lsnr.ranges == std::vector<std::pair<int, int>>{ { 0, 500 }, { 100, 50 }, { 100, -50 }, { 0, -500 } }));
+
+			//An empty range is not a change
+			vec.resize(0);
+			vec.insert(0, 0);
+			Assert::IsTrue(lsnr.ranges.size() == 4);
+		}
 	};
 }
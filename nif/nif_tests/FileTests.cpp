@@ -18,12 +18,32 @@
 
 #include "pch.h"
 #include "CppUnitTest.h"
+#include "EquivalenceTester.h"
+#include "obj/NiDefaultAVObjectPalette.h"
+
+#include <future>
+#include <sstream>
 
 namespace file
 {
 	using namespace Microsoft::VisualStudio::CppUnitTestFramework;
 	using namespace nif;
 
+	//Tests any object against its Niflib object
+	struct EquivalenceTraverser : HorizontalTraverser<EquivalenceTraverser>
+	{
+		EquivalenceTraverser(File& file) : file{ file } {}
+		File& file;
+
+		template<typename T>
+		void invoke(T& object)
+		{
+			auto native = file.getNative<T>(&object);
+			Assert::IsNotNull(static_cast<typename type_map<T>::type*>(native));
+			common::EquivalenceTester<T>{}.down(object, native, file);
+		}
+	};
+
 	TEST_CLASS(ObjectIndexTests)
 	{
 	public:
@@ -61,4 +81,783 @@ namespace file
 			//How to reliably test for destruction of the niflib object?
 		}
 	};
+
+	TEST_CLASS(ObjectTableTests)
+	{
+	public:
+		//The table should list each reachable object once, parents first, and follow changes to references
+		TEST_METHOD(Order)
+		{
+			nif::File file{ nif::File::Version::SKYRIM_SE };
+			auto node = file.create<NiNode>();
+			auto data = file.create<NiStringExtraData>();
+			node->extraData.add(data);
+			file.getRoot()->children.add(node);
+			file.getRoot()->extraData.add(data);
+
+			auto&& table = file.objects();
+			Assert::IsTrue(table.size() == 3);
+			Assert::IsTrue(table[0].object == file.getRoot().get());
+			Assert::IsTrue(table[0].type == BSFadeNode::TYPE && table[0].parent == -1);
+			//extra data is forwarded to before children
+			Assert::IsTrue(table[1].object == data.get() && table[1].parent == 0);
+			Assert::IsTrue(table[2].object == node.get());
+			Assert::IsTrue(table[2].type == NiNode::TYPE && table[2].parent == 0);
+
+			data->value.set("value");
+			Assert::IsTrue(file.objects().size() == 3);
+
+			auto child = file.create<NiNode>();
+			node->children.add(child);
+			Assert::IsTrue(file.objects().size() == 4);
+			Assert::IsTrue(file.objects()[3].object == child.get() && file.objects()[3].parent == 2);
+
+			file.getRoot()->children.remove(node.get());
+			Assert::IsTrue(file.objects().size() == 2);
+		}
+
+		//Every pass should be done with an object before the next object is reached.
+		//Changes made by the passes should be written.
+		TEST_METHOD(Pipeline)
+		{
+			struct Recorder : nif::PipelinePass
+			{
+				Recorder(std::vector<std::pair<int, size_t>>& log, int id) : log{ log }, id{ id } {}
+				virtual void traverse(NiNode& obj) override { log.push_back({ id, index() }); }
+				virtual void traverse(BSFadeNode& obj) override { log.push_back({ id, index() }); }
+				virtual void traverse(NiStringExtraData& obj) override
+				{
+					log.push_back({ id, index() });
+					if (id == 1)
+						obj.value.set("processed");
+				}
+				std::vector<std::pair<int, size_t>>& log;
+				int id;
+			};
+
+			nif::File file{ nif::File::Version::SKYRIM_SE };
+			auto node = file.create<NiNode>();
+			auto data = file.create<NiStringExtraData>();
+			node->extraData.add(data);
+			file.getRoot()->children.add(node);
+
+			std::vector<std::pair<int, size_t>> log;
+			Recorder first(log, 0);
+			Recorder second(log, 1);
+			nif::Pipeline pipeline(nif::Pipeline::Order::CHILDREN_FIRST);
+			pipeline.add(first);
+			pipeline.add(second);
+
+			auto job = file.prepareWrite(pipeline);
+			Assert::IsTrue(job != nullptr);
+			Assert::IsTrue((log == std::vector<std::pair<int, size_t>>{ { 0, 2 }, { 1, 2 }, { 0, 1 }, { 1, 1 }, { 0, 0 }, { 1, 0 } }));
+			//The natives are the job's until it is done
+			job.reset();
+			Assert::IsTrue(file.getNative<NiStringExtraData>(data.get())->GetData() == "processed");
+		}
+	};
+
+	TEST_CLASS(FactoryTests)
+	{
+	public:
+		//A Niflib type that we don't know should give us its most derived type that we do know
+		TEST_METHOD(MostDerived)
+		{
+			nif::File file{ nif::File::Version::SKYRIM_SE };
+
+			auto object = file.get<NiObject>(new Niflib::NiPSysMeshEmitter);
+			Assert::IsTrue(object && object->type() == NiPSysEmitter::TYPE);
+
+			object = file.get<NiObject>(new Niflib::NiPSysBoxEmitter);
+			Assert::IsTrue(object && object->type() == NiPSysBoxEmitter::TYPE);
+		}
+
+		//Files on different threads share the factory lookup
+		TEST_METHOD(Concurrent)
+		{
+			auto work = []()
+			{
+				nif::File file{ nif::File::Version::SKYRIM_SE };
+				for (int i = 0; i < 1000; i++) {
+					auto node = file.get<NiObject>(new Niflib::NiNode);
+					auto emitter = file.get<NiObject>(new Niflib::NiPSysMeshEmitter);
+					if (!node || node->type() != NiNode::TYPE || !emitter || emitter->type() != NiPSysEmitter::TYPE)
+						return false;
+				}
+				return true;
+			};
+
+			std::vector<std::future<bool>> results;
+			for (int i = 0; i < 4; i++)
+				results.push_back(std::async(std::launch::async, work));
+			for (auto&& result : results)
+				Assert::IsTrue(result.get());
+		}
+	};
+
+	TEST_CLASS(LoaderTests)
+	{
+	public:
+		//Every file should get its own result, in order, and failures should not affect the others
+		TEST_METHOD(LoadMany)
+		{
+			std::filesystem::path dir = std::filesystem::temp_directory_path();
+			std::vector<std::filesystem::path> paths;
+			for (int i = 0; i < 8; i++) {
+				paths.push_back(dir / ("svfx_load_many_" + std::to_string(i) + ".nif"));
+				nif::File file{ nif::File::Version::SKYRIM_SE };
+				for (int j = 0; j < i; j++)
+					file.getRoot()->children.add(file.create<NiNode>());
+				file.write(paths.back());
+			}
+			paths.insert(paths.begin() + 3, dir / "svfx_load_many_missing.nif");
+
+			auto results = load_many(paths, 4);
+			Assert::IsTrue(results.size() == paths.size());
+			for (size_t i = 0; i < results.size(); i++) {
+				Assert::IsTrue(results[i].path == paths[i]);
+				if (i == 3) {
+					Assert::IsTrue(results[i].file == nullptr);
+					Assert::IsFalse(results[i].error.empty());
+				}
+				else {
+					Assert::IsTrue(results[i].file && results[i].error.empty());
+					size_t expected = i < 3 ? i : i - 1;
+					Assert::IsTrue(results[i].file->getRoot()->children.size() == expected);
+				}
+			}
+
+			for (auto&& path : paths)
+				std::filesystem::remove(path);
+		}
+
+		//A graph that is large enough to be read on several threads should read the same as on one.
+		//References between the regions (and objects shared by them) must come out right.
+		TEST_METHOD(ParallelRead)
+		{
+			constexpr int SYSTEMS = 8;
+			constexpr int MODIFIERS = 50;
+
+			std::filesystem::path path = std::filesystem::temp_directory_path() / "svfx_parallel_read.nif";
+			{
+				nif::File file{ nif::File::Version::SKYRIM_SE };
+				auto alpha = file.create<NiAlphaProperty>();
+				auto node = file.create<NiNode>();
+				node->name.set("gravity");
+				file.getRoot()->children.add(node);
+				for (int i = 0; i < SYSTEMS; i++) {
+					auto psys = file.create<NiParticleSystem>();
+					psys->name.set(std::to_string(i));
+					psys->alphaProperty.assign(alpha);
+					for (int j = 0; j < MODIFIERS; j++) {
+						auto mod = file.create<NiPSysGravityModifier>();
+						mod->name.set(std::to_string(j));
+						mod->target.assign(psys);
+						if (j == 0)
+							mod->gravityObject.assign(node);
+						psys->modifiers.insert(psys->modifiers.size(), mod);
+					}
+					file.getRoot()->children.add(psys);
+				}
+				file.write(path);
+			}
+
+			for (unsigned int threads : { 1u, 4u }) {
+				nif::File file(path, threads);
+				Assert::IsTrue(file.getRoot()->children.size() == SYSTEMS + 1);
+
+				NiNode* node = nullptr;
+				std::vector<NiParticleSystem*> systems;
+				for (auto&& child : file.getRoot()->children) {
+					if (child->type() == NiParticleSystem::TYPE)
+						systems.push_back(static_cast<NiParticleSystem*>(child.get()));
+					else
+						node = static_cast<NiNode*>(child.get());
+				}
+				Assert::IsTrue(node && node->name.get() == "gravity");
+				Assert::IsTrue(systems.size() == SYSTEMS);
+
+				NiAlphaProperty* alpha = systems.front()->alphaProperty.assigned().get();
+				Assert::IsNotNull(alpha);
+				for (NiParticleSystem* psys : systems) {
+					Assert::IsTrue(psys->alphaProperty.assigned().get() == alpha);
+					Assert::IsTrue(psys->modifiers.size() == MODIFIERS);
+					for (int j = 0; j < MODIFIERS; j++) {
+						auto mod = static_cast<NiPSysGravityModifier*>(psys->modifiers.at(j).get());
+						Assert::IsTrue(mod->name.get() == std::to_string(j));
+						Assert::IsTrue(mod->target.assigned().get() == psys);
+						Assert::IsTrue(mod->gravityObject.assigned().get() == (j == 0 ? node : nullptr));
+					}
+				}
+			}
+
+			std::filesystem::remove(path);
+		}
+
+		//Every object read on several threads should be in the same place in the graph as when read
+		//on one, and be in sync with its Niflib object (through the index, for references)
+		TEST_METHOD(ParallelEquivalence)
+		{
+			constexpr int SYSTEMS = 6;
+			constexpr int MODIFIERS = 50;
+
+			std::filesystem::path path = std::filesystem::temp_directory_path() / "svfx_parallel_equivalence.nif";
+			{
+				nif::File file{ nif::File::Version::SKYRIM_SE };
+				auto alpha = file.create<NiAlphaProperty>();
+				for (int i = 0; i < SYSTEMS; i++) {
+					auto node = file.create<NiNode>();
+					node->name.set("node" + std::to_string(i));
+					auto psys = file.create<NiParticleSystem>();
+					psys->name.set(std::to_string(i));
+					psys->alphaProperty.assign(alpha);
+					auto data = file.create<NiStringExtraData>();
+					data->value.set(std::to_string(i));
+					psys->extraData.add(data);
+					for (int j = 0; j < MODIFIERS; j++) {
+						auto mod = file.create<NiPSysGravityModifier>();
+						mod->name.set(std::to_string(j));
+						mod->target.assign(psys);
+						mod->gravityObject.assign(node);
+						psys->modifiers.insert(psys->modifiers.size(), mod);
+					}
+					node->children.add(psys);
+					file.getRoot()->children.add(node);
+				}
+				file.write(path);
+
+				//Controllers with a block that none of our fields refer to (the palette).
+				//The nodes are not dirty, so the next write keeps them.
+				for (auto&& child : file.getRoot()->children) {
+					Niflib::Ref<Niflib::NiControllerManager> manager = new Niflib::NiControllerManager;
+					manager->SetObjectPalette(new Niflib::NiDefaultAVObjectPalette);
+					file.getNative<NiNode>(static_cast<NiNode*>(child.get()))->AddController(manager);
+				}
+				file.write(path);
+			}
+
+			nif::File serial(path, 1);
+			nif::File parallel(path, 4);
+
+			//Reading is not a change, and the blocks we don't use should not have been created
+			Assert::IsTrue(serial.changes().pending(ChangeLog::Cursor()) == 0);
+			Assert::IsTrue(parallel.changes().pending(ChangeLog::Cursor()) == 0);
+
+			auto&& expected = serial.objects();
+			auto&& actual = parallel.objects();
+			//enough to be read on several threads
+			Assert::IsTrue(expected.size() >= 256);
+			Assert::IsTrue(actual.size() == expected.size());
+
+			EquivalenceTraverser serialTester(serial);
+			EquivalenceTraverser parallelTester(parallel);
+			for (size_t i = 0; i < expected.size(); i++) {
+				Assert::IsTrue(actual[i].type == expected[i].type);
+				Assert::IsTrue(actual[i].parent == expected[i].parent);
+				expected[i].object->dispatch(serialTester);
+				actual[i].object->dispatch(parallelTester);
+				Assert::IsFalse(parallel.isDirty(actual[i].object));
+			}
+
+			std::filesystem::remove(path);
+		}
+	};
+
+	TEST_CLASS(ChangeTrackingTests)
+	{
+	public:
+		//Only objects that changed since the last write should be synced
+		TEST_METHOD(DirtyObjects)
+		{
+			std::filesystem::path path = std::filesystem::temp_directory_path() / "svfx_change_test.nif";
+
+			nif::File file{ nif::File::Version::SKYRIM_SE };
+			auto root = file.getRoot();
+			auto extraData = file.create<NiStringExtraData>();
+			auto strings = file.create<NiStringsExtraData>();
+			Assert::IsTrue(file.isDirty(root.get()));
+			Assert::IsTrue(file.isDirty(extraData.get()));
+
+			root->extraData.add(extraData);
+			root->extraData.add(strings);
+			file.write(path);
+			Assert::IsFalse(file.isDirty(root.get()));
+			Assert::IsFalse(file.isDirty(extraData.get()));
+			Assert::IsFalse(file.isDirty(strings.get()));
+
+			extraData->value.set("value");
+			Assert::IsTrue(file.isDirty(extraData.get()));
+			Assert::IsFalse(file.isDirty(root.get()));
+
+			//Elements of a Vector are tracked as part of their owner
+			strings->strings.push_back();
+			file.write(path);
+			Assert::IsFalse(file.isDirty(strings.get()));
+			strings->strings.back().set("string");
+			Assert::IsTrue(file.isDirty(strings.get()));
+			file.write(path);
+
+			//An object we can't reach is not written, and should stay dirty until we can
+			auto orphan = file.create<NiStringExtraData>();
+			file.write(path);
+			Assert::IsTrue(file.isDirty(orphan.get()));
+
+			nif::File loaded(path);
+			Assert::IsFalse(loaded.isDirty(loaded.getRoot().get()));
+			Assert::IsTrue(loaded.getRoot()->extraData.size() == 2);
+			for (auto&& obj : loaded.getRoot()->extraData) {
+				Assert::IsFalse(loaded.isDirty(obj.get()));
+				if (obj->type() == NiStringExtraData::TYPE)
+					Assert::IsTrue(static_cast<NiStringExtraData*>(obj.get())->value.get() == "value");
+				else {
+					auto&& loadedStrings = static_cast<NiStringsExtraData*>(obj.get())->strings;
+					Assert::IsTrue(loadedStrings.size() == 1 && loadedStrings.at(0).get() == "string");
+				}
+			}
+
+			std::filesystem::remove(path);
+		}
+
+		//Particle systems should be written with the vertex descriptor BS use, even if we don't edit them
+		TEST_METHOD(PSysVertexDescriptor)
+		{
+			constexpr unsigned long long PSYS_DESC = 0x840200004000051;
+
+			std::filesystem::path path = std::filesystem::temp_directory_path() / "svfx_psys_desc_test.nif";
+			auto nativeDesc = [&path]()
+			{
+				auto root = Niflib::DynamicCast<Niflib::NiNode>(Niflib::ReadNifTree(path.string()));
+				Assert::IsTrue(root && root->GetChildren().size() == 1);
+				auto psys = Niflib::DynamicCast<Niflib::NiParticleSystem>(root->GetChildren().front());
+				Assert::IsTrue(psys != nullptr);
+				return static_cast<unsigned long long>(psys->GetVertexDescriptor().bitfield);
+			};
+
+			{
+				nif::File file{ nif::File::Version::SKYRIM_SE };
+				auto psys = file.create<NiParticleSystem>();
+				file.getRoot()->children.add(psys);
+				file.write(path);
+				Assert::IsTrue(nativeDesc() == PSYS_DESC);
+
+				//A file from elsewhere, with some other descriptor
+				file.getNative<NiParticleSystem>(psys.get())->GetVertexDescriptor().bitfield = 0;
+				file.getRoot()->name.set("other");
+				file.write(path);
+				Assert::IsTrue(nativeDesc() == 0);
+			}
+			{
+				//Nothing changes, but the psys should still come out right
+				nif::File file(path);
+				file.getRoot()->name.set("resaved");
+				file.write(path);
+			}
+			Assert::IsTrue(nativeDesc() == PSYS_DESC);
+
+			std::filesystem::remove(path);
+		}
+
+		//Reading objects in is not a change, even inside a batch that outlasts it
+		TEST_METHOD(CreateInBatch)
+		{
+			std::filesystem::path path = std::filesystem::temp_directory_path() / "svfx_batch_test.nif";
+			{
+				nif::File file{ nif::File::Version::SKYRIM_SE };
+				auto data = file.create<NiStringExtraData>();
+				data->name.set("name");
+				data->value.set("value");
+				file.getRoot()->extraData.add(data);
+				file.write(path);
+			}
+
+			std::unique_ptr<nif::File> loaded;
+			std::shared_ptr<NiStringExtraData> created;
+			{
+				ChangeBatch batch;
+				loaded = std::make_unique<nif::File>(path);
+				created = loaded->create<NiStringExtraData>();
+			}
+
+			//Only the new object should be in the journal
+			ChangeLog::Cursor cursor;
+			std::vector<ChangeRecord> changes;
+			Assert::IsTrue(loaded->changes().read(cursor, [&](const ChangeRecord& c) { changes.push_back(c); }));
+			Assert::IsTrue(changes.size() == 1);
+			Assert::IsTrue(changes[0].type == ChangeRecord::CREATE && changes[0].object == created.get());
+
+			Assert::IsFalse(loaded->isDirty(loaded->getRoot().get()));
+			Assert::IsTrue(loaded->getRoot()->extraData.size() == 1);
+			for (auto&& obj : loaded->getRoot()->extraData)
+				Assert::IsFalse(loaded->isDirty(obj.get()));
+
+			std::filesystem::remove(path);
+		}
+
+		//The change log should tell each reader what changed since it last looked
+		TEST_METHOD(Log)
+		{
+			nif::File file{ nif::File::Version::SKYRIM_SE };
+			auto data = file.create<NiStringExtraData>();
+
+			auto cursor = file.changes().cursor();
+			data->value.set("value");
+			file.getRoot()->extraData.add(data);
+
+			std::vector<ChangeRecord> changes;
+			Assert::IsTrue(file.changes().read(cursor, [&](const ChangeRecord& c) { changes.push_back(c); }));
+			Assert::IsTrue(changes.size() == 2);
+			Assert::IsTrue(changes[0].type == ChangeRecord::SET);
+			Assert::IsTrue(changes[0].object == data.get() && changes[0].field == &data->value);
+			Assert::IsTrue(changes[1].type == ChangeRecord::ADD);
+			Assert::IsTrue(changes[1].object == file.getRoot().get());
+			Assert::IsTrue(changes[1].target == static_cast<const NiExtraData*>(data.get()));
+
+			//Nothing new
+			Assert::IsTrue(file.changes().read(cursor, [](const ChangeRecord&) { Assert::Fail(); }));
+
+			//A reader that falls too far behind should be told, and then be up to date
+			for (size_t i = 0; i <= file.changes().capacity(); i++)
+				data->value.set(std::to_string(i));
+			Assert::IsFalse(file.changes().read(cursor, [](const ChangeRecord&) { Assert::Fail(); }));
+			Assert::IsTrue(file.changes().pending(cursor) == 0);
+		}
+
+		//Sets should be recorded with the value before and after, if they are small enough
+		TEST_METHOD(Values)
+		{
+			nif::File file{ nif::File::Version::SKYRIM_SE };
+			auto mod = file.create<NiPSysGravityModifier>();
+			mod->strength.set(1.0f);
+			auto data = file.create<NiStringExtraData>();
+
+			auto cursor = file.changes().cursor();
+			mod->strength.set(2.0f);
+			{
+				//From before the batch to the end of it
+				ChangeBatch batch;
+				mod->strength.set(3.0f);
+				mod->strength.set(4.0f);
+			}
+			data->value.set("value");
+
+			std::vector<ChangeRecord> changes;
+			Assert::IsTrue(file.changes().read(cursor, [&](const ChangeRecord& c) { changes.push_back(c); }));
+			Assert::IsTrue(changes.size() == 3);
+
+			float value;
+			float previous;
+			Assert::IsTrue(changes[0].getValue(value) && value == 2.0f);
+			Assert::IsTrue(changes[0].getPrevious(previous) && previous == 1.0f);
+			Assert::IsTrue(changes[1].getValue(value) && value == 4.0f);
+			Assert::IsTrue(changes[1].getPrevious(previous) && previous == 2.0f);
+
+			//not trivially copyable
+			Assert::IsTrue(changes[2].valueSize == 0 && changes[2].previousSize == 0);
+		}
+	};
+
+	TEST_CLASS(SnapshotTests)
+	{
+	public:
+		//A snapshot should hold the state at the time it was published, and share what has not changed since
+		TEST_METHOD(Sharing)
+		{
+			nif::File file{ nif::File::Version::SKYRIM_SE };
+			for (int i = 0; i < 2; i++) {
+				auto node = file.create<NiNode>();
+				node->name.set(std::to_string(i));
+				auto data = file.create<NiStringExtraData>();
+				data->value.set("before");
+				node->extraData.add(data);
+				file.getRoot()->children.add(node);
+			}
+
+			auto first = file.publish();
+			Assert::IsTrue(first && first->epoch() == 1);
+			Assert::IsTrue(first->getRoot() != file.getRoot());
+			//nothing changed
+			Assert::IsTrue(file.publish() == first);
+
+			auto findChild = [](const std::shared_ptr<NiNode>& root, const std::string& name)
+			{
+				for (auto&& child : root->children)
+					if (child->name.get() == name)
+						return std::static_pointer_cast<NiNode>(child);
+				return std::shared_ptr<NiNode>();
+			};
+			auto valueOf = [](const std::shared_ptr<NiNode>& node)
+			{
+				return std::static_pointer_cast<NiStringExtraData>(*node->extraData.begin())->value.get();
+			};
+
+			auto live = findChild(file.getRoot(), "1");
+			std::static_pointer_cast<NiStringExtraData>(*live->extraData.begin())->value.set("after");
+
+			auto second = file.publish();
+			Assert::IsTrue(second && second->epoch() == 2);
+			Assert::IsTrue(second->getRoot() != first->getRoot());
+			Assert::IsTrue(second->getRoot()->children.size() == 2);
+
+			//node 1 (and its parent) are new copies, node 0 is shared
+			Assert::IsTrue(findChild(second->getRoot(), "0") == findChild(first->getRoot(), "0"));
+			Assert::IsTrue(findChild(second->getRoot(), "1") != findChild(first->getRoot(), "1"));
+			Assert::IsTrue(valueOf(findChild(first->getRoot(), "1")) == "before");
+			Assert::IsTrue(valueOf(findChild(second->getRoot(), "1")) == "after");
+
+			//Structural changes too
+			file.getRoot()->children.remove(live.get());
+			auto third = file.publish();
+			Assert::IsTrue(third->getRoot()->children.size() == 1);
+			Assert::IsTrue(second->getRoot()->children.size() == 2);
+		}
+
+		//Workers should be able to read a snapshot while the file is being edited
+		TEST_METHOD(Concurrent)
+		{
+			constexpr int NODES = 100;
+
+			nif::File file{ nif::File::Version::SKYRIM_SE };
+			for (int i = 0; i < NODES; i++) {
+				auto node = file.create<NiNode>();
+				node->extraData.add(file.create<NiStringExtraData>());
+				file.getRoot()->children.add(node);
+			}
+
+			auto snapshot = file.publish();
+			auto reader = std::async(std::launch::async, [&snapshot]()
+				{
+					size_t count = 0;
+					for (int i = 0; i < 100; i++)
+						for (auto&& child : snapshot->getRoot()->children)
+							count += child->extraData.size();
+					return count;
+				});
+
+			for (auto&& child : file.getRoot()->children)
+				child->extraData.clear();
+			file.getRoot()->children.clear();
+
+			Assert::IsTrue(reader.get() == 100 * NODES);
+		}
+
+		//Changes to objects we can't reach don't make a new snapshot, until we can reach them
+		TEST_METHOD(Unreachable)
+		{
+			nif::File file{ nif::File::Version::SKYRIM_SE };
+			auto node = file.create<NiNode>();
+			file.getRoot()->children.add(node);
+			auto first = file.publish();
+
+			auto orphan = file.create<NiNode>();
+			auto data = file.create<NiStringExtraData>();
+			orphan->extraData.add(data);
+			data->value.set("value");
+			Assert::IsTrue(file.publish() == first);
+
+			node->children.add(orphan);
+			auto second = file.publish();
+			Assert::IsTrue(second != first);
+			auto copy = std::static_pointer_cast<NiNode>(*second->getRoot()->children.begin());
+			Assert::IsTrue(copy->children.size() == 1);
+			auto orphanCopy = std::static_pointer_cast<NiNode>(*copy->children.begin());
+			Assert::IsTrue(orphanCopy != orphan);
+			Assert::IsTrue(std::static_pointer_cast<NiStringExtraData>(*orphanCopy->extraData.begin())->value.get() == "value");
+
+			//and changes below it are tracked from now on
+			data->value.set("changed");
+			auto third = file.publish();
+			copy = std::static_pointer_cast<NiNode>(*third->getRoot()->children.begin());
+			orphanCopy = std::static_pointer_cast<NiNode>(*copy->children.begin());
+			Assert::IsTrue(std::static_pointer_cast<NiStringExtraData>(*orphanCopy->extraData.begin())->value.get() == "changed");
+		}
+
+		//A snapshot can be released on a worker. Its copies are destroyed by the file later.
+		TEST_METHOD(ReleaseOnWorker)
+		{
+			nif::File file{ nif::File::Version::SKYRIM_SE };
+			auto node = file.create<NiNode>();
+			file.getRoot()->children.add(node);
+
+			auto snapshot = file.publish();
+			std::weak_ptr<NiNode> copy = snapshot->getRoot();
+
+			//The next snapshot won't share the root
+			node->name.set("changed");
+			auto next = file.publish();
+
+			std::async(std::launch::async, [s = std::move(snapshot)]() mutable { s.reset(); }).wait();
+			Assert::IsFalse(copy.expired());
+
+			Assert::IsTrue(file.publish() == next);
+			Assert::IsTrue(copy.expired());
+		}
+	};
+
+	TEST_CLASS(HeaderTests)
+	{
+	public:
+		//We should decode the header that Niflib writes, and load the file through the mapping
+		TEST_METHOD(ReadWritten)
+		{
+			std::filesystem::path path = std::filesystem::temp_directory_path() / "svfx_header_test.nif";
+			{
+				nif::File file{ nif::File::Version::SKYRIM_SE };
+				file.getRoot()->extraData.add(file.create<NiStringExtraData>());
+				file.write(path);
+			}
+
+			{
+				MappedFile mapped(path);
+				Header header;
+				Assert::IsTrue(readHeader(mapped.data(), mapped.size(), header));
+				Assert::IsTrue(header.fileVersion() == File::Version::SKYRIM_SE);
+				Assert::IsTrue(header.blockCount() == 2);
+				Assert::IsTrue(header.blockSizes.size() == 2);
+				Assert::IsTrue(header.exportInfo1 == "SVFX Editor");
+				std::set<std::string> types;
+				for (unsigned short index : header.blockTypeIndex)
+					types.insert(header.blockTypes.at(index));
+				Assert::IsTrue(types == std::set<std::string>{ "BSFadeNode", "NiStringExtraData" });
+
+				//Any prefix of the header is reported as incomplete, not as an error
+				Header partial;
+				Assert::IsFalse(readHeader(mapped.data(), header.size - 1, partial));
+			}
+
+			nif::File file(path);
+			Assert::IsTrue(file.getVersion() == File::Version::SKYRIM_SE);
+			Assert::IsTrue(file.getRoot()->extraData.size() == 1);
+
+			std::filesystem::remove(path);
+		}
+
+		//The probe should tell us what a file contains without loading it
+		TEST_METHOD(Probe)
+		{
+			std::filesystem::path path = std::filesystem::temp_directory_path() / "svfx_probe_test.nif";
+			{
+				nif::File file{ nif::File::Version::SKYRIM };
+				for (int i = 0; i < 3; i++)
+					file.getRoot()->extraData.add(file.create<NiStringExtraData>());
+				file.getRoot()->children.add(file.create<NiParticleSystem>());
+				file.write(path);
+			}
+
+			ProbeResult result = probe(path);
+			Assert::IsTrue(result.version == File::Version::SKYRIM);
+			Assert::IsTrue(result.exportInfo1 == "SVFX Editor");
+			Assert::IsTrue(result.blockTypes["NiStringExtraData"] == 3);
+			Assert::IsTrue(result.blockTypes.count("NiParticleSystem") == 1);
+			Assert::IsTrue(result.blockTypes.count("BSFadeNode") == 1);
+
+			unsigned int total = 0;
+			for (auto&& entry : result.blockTypes)
+				total += entry.second;
+			Assert::IsTrue(total == result.blockCount);
+
+			std::filesystem::remove(path);
+
+			Assert::ExpectException<std::runtime_error>([&]() { probe(path); });
+		}
+
+		//Buffering should not change what we write
+		TEST_METHOD(BufferedWrite)
+		{
+			std::filesystem::path path = std::filesystem::temp_directory_path() / "svfx_write_test.nif";
+
+			nif::File file{ nif::File::Version::SKYRIM_SE };
+			for (int i = 0; i < 1000; i++) {
+				auto data = file.create<NiStringExtraData>();
+				data->value.set(std::to_string(i));
+				file.getRoot()->extraData.add(data);
+			}
+			file.write(path);
+
+			std::string written;
+			{
+				MappedFile mapped(path);
+				written.assign(mapped.data(), mapped.size());
+			}
+
+			Niflib::NifInfo info;
+			info.version = 0x14020007;
+			info.userVersion = 12;
+			info.userVersion2 = 100;
+			info.exportInfo1 = "SVFX Editor";
+			info.exportInfo2 = "Niflib";
+			std::ostringstream expected(std::ios_base::binary);
+			Niflib::WriteNifTree(expected, static_cast<Niflib::NiObject*>(file.getNative<NiNode>(file.getRoot().get())), info);
+
+			Assert::IsTrue(written == expected.str());
+
+			std::filesystem::remove(path);
+		}
+
+		//A prepared write should hold the state at the time it was prepared
+		TEST_METHOD(WriteJob)
+		{
+			std::filesystem::path path = std::filesystem::temp_directory_path() / "svfx_job_test.nif";
+			{
+				nif::File file{ nif::File::Version::SKYRIM_SE };
+				auto data = file.create<NiStringExtraData>();
+				data->value.set("before");
+				file.getRoot()->extraData.add(data);
+
+				auto job = file.prepareWrite();
+				Assert::IsTrue(job != nullptr);
+
+				data->value.set("after");
+				file.getRoot()->extraData.clear();
+
+				std::async(std::launch::async, [&]() { job->write(path); }).get();
+				Assert::IsFalse(std::filesystem::exists(path.string() + ".tmp"));
+			}
+
+			nif::File file(path);
+			Assert::IsTrue(file.getRoot()->extraData.size() == 1);
+			auto data = std::static_pointer_cast<NiStringExtraData>(*file.getRoot()->extraData.begin());
+			Assert::IsTrue(data->value.get() == "before");
+
+			std::filesystem::remove(path);
+		}
+
+		//Objects we can't reach may still refer to natives that a job is writing. The job should keep
+		//them alive, so that they are not destroyed (releasing those natives) while it runs.
+		TEST_METHOD(WriteJobKeepsObjects)
+		{
+			std::filesystem::path path = std::filesystem::temp_directory_path() / "svfx_job_keeps_test.nif";
+			nif::File file{ nif::File::Version::SKYRIM_SE };
+			auto shared = file.create<NiNode>();
+			auto detached = file.create<NiNode>();
+			detached->children.add(shared);
+			file.getRoot()->children.add(detached);
+			file.getRoot()->children.add(shared);
+			file.write(path);
+
+			//detached's native still refers to shared's. Someone else holds it (e.g. an undo stack).
+			file.getRoot()->children.remove(detached.get());
+
+			auto job = file.prepareWrite();
+			Assert::IsTrue(job != nullptr);
+
+			std::weak_ptr<NiNode> weak = detached;
+			detached.reset();
+			file.getRoot()->children.clear();
+			shared.reset();
+			Assert::IsFalse(weak.expired());
+
+			std::async(std::launch::async, [&]() { job->write(path); }).get();
+			job.reset();
+			Assert::IsTrue(weak.expired());
+
+			std::filesystem::remove(path);
+		}
+
+		TEST_METHOD(NotANif)
+		{
+			const char data[] = "This is not a nif file, but it has a line break\n and then some";
+			Header header;
+			Assert::ExpectException<std::runtime_error>([&]() { readHeader(data, sizeof(data), header); });
+		}
+	};
 }
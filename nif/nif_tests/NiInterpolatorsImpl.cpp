@@ -32,13 +32,13 @@ bool common::EquivalenceTester<nif::NiBoolData>::operator()(const NiBoolData& ob
 	auto&& keys = native->GetKeys();
 	Assert::IsTrue(object.keys.size() == keys.size());
 	for (size_t i = 0; i < keys.size(); i++) {
-		Assert::IsTrue(object.keys.at(i).time.get() == keys[i].time);
-		Assert::IsTrue(object.keys.at(i).value.get() == (bool)keys[i].data);
-		Assert::IsTrue(object.keys.at(i).fwdTan.get() == (bool)keys[i].forward_tangent);
-		Assert::IsTrue(object.keys.at(i).bwdTan.get() == (bool)keys[i].backward_tangent);
-		Assert::IsTrue(object.keys.at(i).tension.get() == keys[i].tension);
-		Assert::IsTrue(object.keys.at(i).bias.get() == keys[i].bias);
-		Assert::IsTrue(object.keys.at(i).continuity.get() == keys[i].continuity);
+		Assert::IsTrue(object.keys.get<KeyColumn::TIME>(i) == keys[i].time);
+		Assert::IsTrue(object.keys.get<KeyColumn::VALUE>(i) == (bool)keys[i].data);
+		Assert::IsTrue(object.keys.get<KeyColumn::FWD_TAN>(i) == (bool)keys[i].forward_tangent);
+		Assert::IsTrue(object.keys.get<KeyColumn::BWD_TAN>(i) == (bool)keys[i].backward_tangent);
+		Assert::IsTrue(object.keys.get<KeyColumn::TENSION>(i) == keys[i].tension);
+		Assert::IsTrue(object.keys.get<KeyColumn::BIAS>(i) == keys[i].bias);
+		Assert::IsTrue(object.keys.get<KeyColumn::CONTINUITY>(i) == keys[i].continuity);
 	}
 
 	return true;
@@ -53,14 +53,14 @@ bool common::Randomiser<NiBoolData>::operator()(NiBoolData& object, File& file,
 	std::uniform_int_distribution<int> B{ 0, 1 };
 
 	object.keys.resize(size(rng));
-	for (auto&& key : object.keys) {
-		key.time.set(F(rng));
-		key.value.set(B(rng));
-		key.fwdTan.set(B(rng));
-		key.bwdTan.set(B(rng));
-		key.tension.set(F(rng));
-		key.bias.set(F(rng));
-		key.continuity.set(F(rng));
+	for (int i = 0; i < (int)object.keys.size(); i++) {
+		object.keys.set<KeyColumn::TIME>(i, F(rng));
+		object.keys.set<KeyColumn::VALUE>(i, B(rng));
+		object.keys.set<KeyColumn::FWD_TAN>(i, B(rng));
+		object.keys.set<KeyColumn::BWD_TAN>(i, B(rng));
+		object.keys.set<KeyColumn::TENSION>(i, F(rng));
+		object.keys.set<KeyColumn::BIAS>(i, F(rng));
+		object.keys.set<KeyColumn::CONTINUITY>(i, F(rng));
 	}
 
 	return true;
@@ -90,13 +90,13 @@ bool common::EquivalenceTester<nif::NiFloatData>::operator()(const NiFloatData&
 	auto&& keys = native->GetKeys();
 	Assert::IsTrue(object.keys.size() == keys.size());
 	for (size_t i = 0; i < keys.size(); i++) {
-		Assert::IsTrue(object.keys.at(i).time.get() == keys[i].time);
-		Assert::IsTrue(object.keys.at(i).value.get() == keys[i].data);
-		Assert::IsTrue(object.keys.at(i).fwdTan.get() == keys[i].forward_tangent);
-		Assert::IsTrue(object.keys.at(i).bwdTan.get() == keys[i].backward_tangent);
-		Assert::IsTrue(object.keys.at(i).tension.get() == keys[i].tension);
-		Assert::IsTrue(object.keys.at(i).bias.get() == keys[i].bias);
-		Assert::IsTrue(object.keys.at(i).continuity.get() == keys[i].continuity);
+		Assert::IsTrue(object.keys.get<KeyColumn::TIME>(i) == keys[i].time);
+		Assert::IsTrue(object.keys.get<KeyColumn::VALUE>(i) == keys[i].data);
+		Assert::IsTrue(object.keys.get<KeyColumn::FWD_TAN>(i) == keys[i].forward_tangent);
+		Assert::IsTrue(object.keys.get<KeyColumn::BWD_TAN>(i) == keys[i].backward_tangent);
+		Assert::IsTrue(object.keys.get<KeyColumn::TENSION>(i) == keys[i].tension);
+		Assert::IsTrue(object.keys.get<KeyColumn::BIAS>(i) == keys[i].bias);
+		Assert::IsTrue(object.keys.get<KeyColumn::CONTINUITY>(i) == keys[i].continuity);
 	}
 
 	return true;
@@ -110,14 +110,14 @@ bool common::Randomiser<NiFloatData>::operator()(NiFloatData& object, File& file
 	std::uniform_real_distribution<float> F;
 
 	object.keys.resize(size(rng));
-	for (auto&& key : object.keys) {
-		key.time.set(F(rng));
-		key.value.set(F(rng));
-		key.fwdTan.set(F(rng));
-		key.bwdTan.set(F(rng));
-		key.tension.set(F(rng));
-		key.bias.set(F(rng));
-		key.continuity.set(F(rng));
+	for (int i = 0; i < (int)object.keys.size(); i++) {
+		object.keys.set<KeyColumn::TIME>(i, F(rng));
+		object.keys.set<KeyColumn::VALUE>(i, F(rng));
+		object.keys.set<KeyColumn::FWD_TAN>(i, F(rng));
+		object.keys.set<KeyColumn::BWD_TAN>(i, F(rng));
+		object.keys.set<KeyColumn::TENSION>(i, F(rng));
+		object.keys.set<KeyColumn::BIAS>(i, F(rng));
+		object.keys.set<KeyColumn::CONTINUITY>(i, F(rng));
 	}
 
 	return true;
@@ -120,6 +120,15 @@ namespace objects
 			HorizontalTestTraverser t{ type };
 			static_cast<nif::NiObject&>(object).receive(t);
 			Assert::IsTrue(type == T::TYPE);
+
+			//The dispatch table should take us to the same invoke, as should dispatch without it
+			Assert::IsTrue(object.ordinal() == nif::type_ordinal<T>);
+			for (nif::Dispatch mode : { nif::Dispatch::TABLE, nif::Dispatch::VIRTUAL }) {
+				type = nif::NiObject::TYPE;
+				t.setDispatch(mode);
+				static_cast<nif::NiObject&>(object).dispatch(t);
+				Assert::IsTrue(type == T::TYPE);
+			}
 		}
 	};
 	template<typename T>
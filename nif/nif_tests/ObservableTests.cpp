@@ -70,6 +70,73 @@ namespace fields
 			Assert::IsFalse(l1.received());
 		}
 
+		//More listeners than fit in place
+		TEST_METHOD(add_remove_many)
+		{
+			constexpr int N = 5;
+			Observable<void> o;
+			Listener l[N];
+			for (int i = 0; i < N; i++) {
+				o.addListener(l[i]);
+				o.addListener(l[i]);//should be ignored
+			}
+
+			o.signal(Event<void>());
+			for (int i = 0; i < N; i++)
+				Assert::IsTrue(l[i].received());
+
+			o.removeListener(l[1]);
+			o.removeListener(l[3]);
+			o.signal(Event<void>());
+			for (int i = 0; i < N; i++)
+				Assert::IsTrue(l[i].received() == (i != 1 && i != 3));
+
+			Observable<void> o2(std::move(o));
+			o.signal(Event<void>());
+			for (int i = 0; i < N; i++)
+				Assert::IsFalse(l[i].received());
+
+			o2.signal(Event<void>());
+			Assert::IsTrue(l[0].received());
+			Assert::IsTrue(l[4].received());
+		}
+
+		//Removing takes the last listener to the vacated slot. Everyone else must stay subscribed.
+		TEST_METHOD(remove_overflowed)
+		{
+			constexpr int N = 8;
+			Observable<void> o;
+			Listener l[N];
+			for (int i = 0; i < N; i++)
+				o.addListener(l[i]);
+
+			//the first, the last (which has moved to the first slot), another, and one that is not there
+			bool subscribed[N];
+			std::fill(std::begin(subscribed), std::end(subscribed), true);
+			for (int i : { 0, N - 1, 1, 0 }) {
+				o.removeListener(l[i]);
+				subscribed[i] = false;
+				o.signal(Event<void>());
+				for (int j = 0; j < N; j++)
+					Assert::IsTrue(l[j].received() == subscribed[j]);
+			}
+
+			//and back
+			o.addListener(l[0]);
+			o.addListener(l[0]);
+			o.signal(Event<void>());
+			Assert::IsTrue(l[0].received());
+			o.removeListener(l[0]);
+			o.signal(Event<void>());
+			Assert::IsFalse(l[0].received());
+
+			for (int i = 0; i < N; i++)
+				o.removeListener(l[i]);
+			o.signal(Event<void>());
+			for (int i = 0; i < N; i++)
+				Assert::IsFalse(l[i].received());
+		}
+
 		TEST_METHOD(add_loop)
 		{
 			struct LoopListener : Listener
@@ -150,5 +217,30 @@ namespace fields
 			o2.signal(Event<void>());
 			Assert::IsTrue(l.received());
 		}
+
+		//Listener storage taken from an arena keeps the arena alive
+		TEST_METHOD(Outlive_arena)
+		{
+			constexpr int N = 5;
+			auto resource = std::make_shared<std::pmr::unsynchronized_pool_resource>();
+			std::weak_ptr<std::pmr::memory_resource> weak = resource;
+
+			auto o = std::make_unique<Observable<void>>();
+			Listener l[N];
+			{
+				ObservableArena arena(resource);
+				for (int i = 0; i < N; i++)
+					o->addListener(l[i]);
+			}
+			resource.reset();
+			Assert::IsFalse(weak.expired());
+
+			o->signal(Event<void>());
+			for (int i = 0; i < N; i++)
+				Assert::IsTrue(l[i].received());
+
+			o.reset();
+			Assert::IsTrue(weak.expired());
+		}
 	};
 }
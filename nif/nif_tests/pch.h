@@ -25,5 +25,7 @@
 
 #include "nif.h"
 #include "nif_internal.h"
+#include "Header.h"
+#include "MappedFile.h"
 
 #endif //PCH_H
@@ -0,0 +1,186 @@
+//Copyright 2021 Jonas Gernandt
+//
+//This file is part of SVFX Editor, a program for creating visual effects
+//in the NetImmerse format.
+//
+//SVFX Editor is free software: you can redistribute it and/or modify
+//it under the terms of the GNU General Public License as published by
+//the Free Software Foundation, either version 3 of the License, or
+//(at your option) any later version.
+//
+//SVFX Editor is distributed in the hope that it will be useful,
+//but WITHOUT ANY WARRANTY; without even the implied warranty of
+//MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//GNU General Public License for more details.
+//
+//You should have received a copy of the GNU General Public License
+//along with SVFX Editor. If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+namespace nif
+{
+	struct NiObject;
+
+	//One change to one of our objects. Trivially copyable, so that it can live in a ring buffer.
+	//The addresses identify what changed. They are only safe to dereference if we know that the
+	//object is still alive (i.e. there is no later DESTROY record for it).
+	struct ChangeRecord
+	{
+		enum Type : std::uint8_t
+		{
+			CREATE,//object was created
+			DESTROY,//object was destroyed
+			SET,//field was set (from previous to value, if we could record them), or count keys of column were set
+			RAISE,//flags in value were raised
+			CLEAR,//flags in value were cleared
+			INSERT,//count elements were inserted at pos
+			ERASE,//count elements were erased at pos
+			MOVE,//the element at pos was moved to pos2
+			ADD,//target was added to a set
+			REMOVE,//target was removed from a set
+			ASSIGN,//target (possibly null) was assigned to a reference
+		};
+
+		//Values up to this size are recorded, if they can be copied as bytes
+		constexpr static size_t VALUE_SIZE = 16;
+
+		template<typename T>
+		constexpr static bool recordable = std::is_trivially_copyable_v<T> && sizeof(T) <= VALUE_SIZE;
+
+		Type type{ SET };
+		std::uint8_t column{ 0 };//KeyColumn, for key tables
+		std::uint8_t valueSize{ 0 };//0 if no value was recorded
+		std::uint8_t previousSize{ 0 };//0 if no previous value was recorded
+		//The field refers to other objects (a Ref, Ptr, Set or Sequence)
+		bool reference{ false };
+		int pos{ -1 };
+		int pos2{ -1 };
+		int count{ 0 };
+		const NiObject* object{ nullptr };
+		//The member of object that changed (null for CREATE/DESTROY)
+		const void* field{ nullptr };
+		const void* target{ nullptr };
+		unsigned char value[VALUE_SIZE]{};
+		unsigned char previous[VALUE_SIZE]{};
+
+		//The new value
+		template<typename T>
+		void setValue(const T& val) { valueSize = put(value, val); }
+		//False if no value of this size was recorded
+		template<typename T>
+		bool getValue(T& out) const { return take(value, valueSize, out); }
+
+		//The value before the change
+		template<typename T>
+		void setPrevious(const T& val) { previousSize = put(previous, val); }
+		template<typename T>
+		bool getPrevious(T& out) const { return take(previous, previousSize, out); }
+
+	private:
+		template<typename T>
+		static std::uint8_t put(unsigned char (&to)[VALUE_SIZE], const T& val)
+		{
+			if constexpr (recordable<T>) {
+				std::memcpy(to, &val, sizeof(T));
+				return static_cast<std::uint8_t>(sizeof(T));
+			}
+			else
+				return 0;
+		}
+		template<typename T>
+		static bool take(const unsigned char (&from)[VALUE_SIZE], std::uint8_t size, T& out)
+		{
+			static_assert(recordable<T>);
+			if (size == sizeof(T)) {
+				std::memcpy(&out, from, sizeof(T));
+				return true;
+			}
+			else
+				return false;
+		}
+	};
+
+	//An ordered log of the changes made to the objects of a File, in bounded memory.
+	//Any number of consumers can read it, each through its own Cursor and at its own pace.
+	//A consumer that falls more than capacity records behind has lost the records it missed,
+	//and must look at the objects themselves to find out where it stands.
+	class ChangeLog
+	{
+	public:
+		constexpr static size_t DEFAULT_CAPACITY = 4096;
+
+		class Cursor
+		{
+		public:
+			Cursor() = default;
+
+		private:
+			friend class ChangeLog;
+			std::uint64_t m_next{ 0 };
+		};
+
+	public:
+		//Capacity is rounded up to a power of two. Memory is only taken as records are appended.
+		ChangeLog(size_t capacity = DEFAULT_CAPACITY)
+		{
+			assert(capacity > 0);
+			m_capacity = 1;
+			while (m_capacity < capacity)
+				m_capacity *= 2;
+		}
+		ChangeLog(const ChangeLog&) = delete;
+		~ChangeLog() = default;
+
+		ChangeLog& operator=(const ChangeLog&) = delete;
+
+		void append(const ChangeRecord& change)
+		{
+			if (m_ring.size() < m_capacity)
+				m_ring.push_back(change);
+			else
+				m_ring[m_end & (m_capacity - 1)] = change;
+			m_end++;
+		}
+
+		//A cursor positioned after the latest record, i.e. one that will read what happens from now on
+		Cursor cursor() const
+		{
+			Cursor result;
+			result.m_next = m_end;
+			return result;
+		}
+
+		//Calls f with each record appended since cursor, in order, and moves cursor to the end.
+		//Returns false (without calling f) if any of them have been overwritten.
+		template<typename Fcn>
+		bool read(Cursor& cursor, Fcn&& f) const
+		{
+			assert(cursor.m_next <= m_end);
+
+			bool complete = m_end - cursor.m_next <= m_capacity;
+			if (complete) {
+				for (std::uint64_t i = cursor.m_next; i < m_end; i++)
+					f(m_ring[i & (m_capacity - 1)]);
+			}
+			cursor.m_next = m_end;
+			return complete;
+		}
+
+		//Number of records appended since cursor (possibly more than we hold)
+		std::uint64_t pending(const Cursor& cursor) const { return m_end - cursor.m_next; }
+
+		size_t capacity() const { return m_capacity; }
+
+	private:
+		std::vector<ChangeRecord> m_ring;
+		size_t m_capacity;
+		//Number of records ever appended
+		std::uint64_t m_end{ 0 };
+	};
+}
@@ -0,0 +1,372 @@
+//Copyright 2021 Jonas Gernandt
+//
+//This file is part of SVFX Editor, a program for creating visual effects
+//in the NetImmerse format.
+//
+//SVFX Editor is free software: you can redistribute it and/or modify
+//it under the terms of the GNU General Public License as published by
+//the Free Software Foundation, either version 3 of the License, or
+//(at your option) any later version.
+//
+//SVFX Editor is distributed in the hope that it will be useful,
+//but WITHOUT ANY WARRANTY; without even the implied warranty of
+//MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//GNU General Public License for more details.
+//
+//You should have received a copy of the GNU General Public License
+//along with SVFX Editor. If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+#include <memory>
+#include <set>
+#include <type_traits>
+
+#include "nif_objects.h"
+#include "ChangeLog.h"
+
+namespace nif
+{
+	//Records the changes to our objects in a ChangeLog, and keeps the set of objects that have
+	//changed since they were last written to their Niflib object.
+	//The dirty set can't be a consumer of the log like any other. It must not lose track of
+	//objects, so it is updated as changes are recorded.
+	class ChangeJournal
+	{
+	public:
+		void record(const ChangeRecord& change)
+		{
+			assert(change.object);
+			if (m_enabled) {
+				m_dirty.insert(change.object);
+				m_log.append(change);
+			}
+		}
+		void created(const NiObject* object)
+		{
+			ChangeRecord change;
+			change.type = ChangeRecord::CREATE;
+			change.object = object;
+			record(change);
+		}
+		//Always recorded (unless discarding), anyone holding the address should hear about it
+		void destroyed(const NiObject* object)
+		{
+			m_dirty.erase(object);
+
+			if (!m_discarding) {
+				ChangeRecord change;
+				change.type = ChangeRecord::DESTROY;
+				change.object = object;
+				m_log.append(change);
+			}
+		}
+
+		void clean(const NiObject* object) { m_dirty.erase(object); }
+		void clear() { m_dirty.clear(); }
+
+		bool isDirty(const NiObject* object) const { return m_dirty.find(object) != m_dirty.end(); }
+		size_t size() const { return m_dirty.size(); }
+		const std::set<const NiObject*>& dirty() const { return m_dirty; }
+
+		const ChangeLog& log() const { return m_log; }
+
+		//Stops recording changes for as long as it lives, e.g. while we are reading from Niflib
+		class Suspension
+		{
+		public:
+			Suspension(ChangeJournal& journal) : m_journal{ journal }, m_wasEnabled{ journal.m_enabled }
+			{
+				m_journal.m_enabled = false;
+			}
+			Suspension(const Suspension&) = delete;
+			~Suspension() { m_journal.m_enabled = m_wasEnabled; }
+
+			Suspension& operator=(const Suspension&) = delete;
+
+		private:
+			ChangeJournal& m_journal;
+			const bool m_wasEnabled;
+		};
+
+		//Stops recording destructions for as long as it lives. Only for objects that no one can have
+		//heard of, e.g. those that a load created but never attached to anything.
+		class Discarding
+		{
+		public:
+			Discarding(ChangeJournal& journal) : m_journal{ journal }, m_wasDiscarding{ journal.m_discarding }
+			{
+				m_journal.m_discarding = true;
+			}
+			Discarding(const Discarding&) = delete;
+			~Discarding() { m_journal.m_discarding = m_wasDiscarding; }
+
+			Discarding& operator=(const Discarding&) = delete;
+
+		private:
+			ChangeJournal& m_journal;
+			const bool m_wasDiscarding;
+		};
+
+	private:
+		std::set<const NiObject*> m_dirty;
+		ChangeLog m_log;
+		bool m_enabled{ true };
+		bool m_discarding{ false };
+	};
+
+	class ChangeTracker;
+
+	//Defined in FieldTable.h
+	template<typename T> bool subscribeFields(T& object, ChangeTracker& tracker);
+
+	//Lists the fields of T that should be tracked for changes.
+	//By default, the fields in the field_table of T. Specialise and implement for anything else.
+	template<typename T>
+	struct ChangeSubscriber : VerticalTraverser<T, ChangeSubscriber>
+	{
+		bool operator() (T& object, ChangeTracker& tracker) { return subscribeFields(object, tracker); }
+	};
+
+	namespace detail
+	{
+		template<typename... Ts> struct type_list {};
+
+		//Appends T to the list, unless it is already in it
+		template<typename List, typename T> struct append_unique;
+		template<typename... Ts, typename T>
+		struct append_unique<type_list<Ts...>, T>
+		{
+			using type = std::conditional_t<(std::is_same_v<T, Ts> || ...), type_list<Ts...>, type_list<Ts..., T>>;
+		};
+
+		template<typename List, typename... Ts>
+		struct make_unique_list { using type = List; };
+		template<typename List, typename T, typename... Ts>
+		struct make_unique_list<List, T, Ts...> : make_unique_list<typename append_unique<List, T>::type, Ts...> {};
+
+		//Many of our field types are aliases of each other (KeyType, ForceType, ShaderFlags...).
+		//We can only inherit each listener once, so duplicates must go.
+		template<typename... Ts>
+		using unique_list = typename make_unique_list<type_list<>, Ts...>::type;
+
+		using TrackedFields = unique_list<
+			Property<std::string>,
+			Property<translation_t>,
+			Property<rotation_t>,
+			Property<float>,
+			Property<bool>,
+			Property<BillboardMode>,
+			Property<AlphaMode>,
+			Property<BlendFunction>,
+			Property<TestFunction>,
+			Property<std::uint_fast8_t>,
+			Property<ColRGBA>,
+			Property<KeyType>,
+			Property<unsigned short>,
+			Property<unsigned int>,
+			Property<std::vector<SubtextureOffset>>,
+			Property<Floats<3>>,
+			Property<ForceType>,
+			Property<math::degf>,
+			Property<std::vector<float>>,
+			FlagSet<std::uint_fast32_t>,
+			FlagSet<ControllerFlags>,
+			FlagSet<ShaderFlags>,
+			KeyTable<bool>,
+			KeyTable<float>,
+			Vector<Property<std::string>>,
+			Set<NiExtraData>,
+			Set<NiAVObject>,
+			Sequence<NiTimeController>,
+			Sequence<NiPSysModifier>,
+			Assignable<NiBoolData>,
+			Assignable<NiFloatData>,
+			Assignable<NiInterpolator>,
+			Assignable<NiObjectNET>,
+			Assignable<NiPSysData>,
+			Assignable<BSShaderProperty>,
+			Assignable<NiAlphaProperty>,
+			Assignable<NiParticleSystem>,
+			Assignable<NiNode>>;
+
+		template<typename Derived, typename Field>
+		class ChangeSlot : public IListener<Field>
+		{
+		public:
+			virtual void receive(const Event<Field>& e, Observable<Field>& o) override
+			{
+				static_cast<Derived&>(*this).changed(e, o);
+			}
+		};
+
+		template<typename Derived, typename List> struct ChangeSlots;
+		template<typename Derived, typename... Fields>
+		struct ChangeSlots<Derived, type_list<Fields...>> : ChangeSlot<Derived, Fields>... {};
+	}
+
+	//Listens to the fields of one object and records their changes in a ChangeJournal.
+	//Lives in the same block as the object it tracks, and must outlive the object's fields.
+	class ChangeTracker final : public detail::ChangeSlots<ChangeTracker, detail::TrackedFields>
+	{
+		template<typename Derived, typename Field> friend class detail::ChangeSlot;
+
+	public:
+		ChangeTracker() = default;
+		ChangeTracker(const ChangeTracker&) = delete;
+		ChangeTracker(ChangeTracker&&) = delete;
+
+		~ChangeTracker()
+		{
+			if (m_journal)
+				m_journal->destroyed(m_object);
+		}
+
+		ChangeTracker& operator=(const ChangeTracker&) = delete;
+		ChangeTracker& operator=(ChangeTracker&&) = delete;
+
+		void attach(const NiObject* object, const std::shared_ptr<ChangeJournal>& journal)
+		{
+			m_object = object;
+			m_journal = journal;
+		}
+
+		template<typename Field>
+		void subscribe(Field& field)
+		{
+			field.addListener(*this);
+		}
+
+		//Elements of a Vector are fields in their own right
+		template<typename T>
+		void subscribe(Vector<T>& field)
+		{
+			field.addListener(*this);
+			for (auto&& element : field)
+				subscribe(element);
+		}
+
+	private:
+		template<typename Field>
+		ChangeRecord makeRecord(ChangeRecord::Type type, Observable<Field>& o) const
+		{
+			ChangeRecord change;
+			change.type = type;
+			change.object = m_object;
+			change.field = &static_cast<Field&>(o);
+			return change;
+		}
+
+		void record(const ChangeRecord& change)
+		{
+			if (m_journal)
+				m_journal->record(change);
+		}
+
+		template<typename T>
+		void changed(const Event<Property<T>>& e, Observable<Property<T>>& o)
+		{
+			ChangeRecord change = makeRecord(ChangeRecord::SET, o);
+			change.setValue(e.value);
+			if (e.previous)
+				change.setPrevious(*e.previous);
+			record(change);
+		}
+
+		template<typename T>
+		void changed(const Event<FlagSet<T>>& e, Observable<FlagSet<T>>& o)
+		{
+			ChangeRecord change = makeRecord(
+				e.type == Event<FlagSet<T>>::RAISE ? ChangeRecord::RAISE : ChangeRecord::CLEAR, o);
+			change.setValue(e.flags);
+			record(change);
+		}
+
+		template<typename T>
+		void changed(const Event<KeyTable<T>>& e, Observable<KeyTable<T>>& o)
+		{
+			ChangeRecord change;
+			switch (e.type) {
+			case Event<KeyTable<T>>::INSERT:
+				change = makeRecord(ChangeRecord::INSERT, o);
+				break;
+			case Event<KeyTable<T>>::ERASE:
+				change = makeRecord(ChangeRecord::ERASE, o);
+				break;
+			case Event<KeyTable<T>>::MOVE:
+				change = makeRecord(ChangeRecord::MOVE, o);
+				break;
+			case Event<KeyTable<T>>::SET:
+				change = makeRecord(ChangeRecord::SET, o);
+				change.column = static_cast<std::uint8_t>(e.column);
+				break;
+			}
+			change.pos = e.pos1;
+			change.pos2 = e.pos2;
+			change.count = e.count;
+			record(change);
+		}
+
+		template<typename T>
+		void changed(const Event<Vector<T>>& e, Observable<Vector<T>>& o)
+		{
+			ChangeRecord change;
+			switch (e.type) {
+			case Event<Vector<T>>::INSERT:
+			case Event<Vector<T>>::INSERT_RANGE:
+				change = makeRecord(ChangeRecord::INSERT, o);
+				break;
+			case Event<Vector<T>>::ERASE:
+			case Event<Vector<T>>::ERASE_RANGE:
+				change = makeRecord(ChangeRecord::ERASE, o);
+				break;
+			case Event<Vector<T>>::MOVE:
+				change = makeRecord(ChangeRecord::MOVE, o);
+				break;
+			}
+			change.pos = e.pos1;
+			change.pos2 = e.pos2;
+			change.count = e.type == Event<Vector<T>>::INSERT_RANGE || e.type == Event<Vector<T>>::ERASE_RANGE ? e.count : 1;
+			record(change);
+
+			if (e.type == Event<Vector<T>>::INSERT)
+				subscribe(static_cast<Vector<T>&>(o).at(e.pos1));
+			else if (e.type == Event<Vector<T>>::INSERT_RANGE) {
+				for (int i = 0; i < e.count; i++)
+					subscribe(static_cast<Vector<T>&>(o).at(e.pos1 + i));
+			}
+		}
+
+		template<typename T>
+		void changed(const Event<Sequence<T>>& e, Observable<Sequence<T>>& o)
+		{
+			bool insert = e.type == Event<Sequence<T>>::INSERT || e.type == Event<Sequence<T>>::INSERT_RANGE;
+			ChangeRecord change = makeRecord(insert ? ChangeRecord::INSERT : ChangeRecord::ERASE, o);
+			change.reference = true;
+			change.pos = e.pos;
+			change.count = e.type == Event<Sequence<T>>::INSERT_RANGE || e.type == Event<Sequence<T>>::ERASE_RANGE ? e.count : 1;
+			record(change);
+		}
+
+		template<typename T>
+		void changed(const Event<Set<T>>& e, Observable<Set<T>>& o)
+		{
+			ChangeRecord change = makeRecord(e.type == Event<Set<T>>::ADD ? ChangeRecord::ADD : ChangeRecord::REMOVE, o);
+			change.reference = true;
+			change.target = e.obj;
+			record(change);
+		}
+
+		template<typename T>
+		void changed(const Event<Assignable<T>>& e, Observable<Assignable<T>>& o)
+		{
+			ChangeRecord change = makeRecord(ChangeRecord::ASSIGN, o);
+			change.reference = true;
+			change.target = e.obj;
+			record(change);
+		}
+
+	private:
+		const NiObject* m_object{ nullptr };
+		std::shared_ptr<ChangeJournal> m_journal;
+	};
+}
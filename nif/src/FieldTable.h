@@ -0,0 +1,135 @@
+//Copyright 2021 Jonas Gernandt
+//
+//This file is part of SVFX Editor, a program for creating visual effects
+//in the NetImmerse format.
+//
+//SVFX Editor is free software: you can redistribute it and/or modify
+//it under the terms of the GNU General Public License as published by
+//the Free Software Foundation, either version 3 of the License, or
+//(at your option) any later version.
+//
+//SVFX Editor is distributed in the hope that it will be useful,
+//but WITHOUT ANY WARRANTY; without even the implied warranty of
+//MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//GNU General Public License for more details.
+//
+//You should have received a copy of the GNU General Public License
+//along with SVFX Editor. If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+#include <tuple>
+#include <type_traits>
+#include "nif_conversions.h"
+#include "ChangeTracker.h"
+#include "File.h"
+
+namespace nif
+{
+	//A field of Object, and the native accessors that it is synced through.
+	//Member is a Property, Ref or Ptr.
+	template<typename Object, typename Member, typename Getter, typename Setter>
+	struct FieldDescriptor
+	{
+		Member Object::* member;
+		Getter get;
+		Setter set;
+	};
+
+	template<typename Object, typename Member, typename Getter, typename Setter>
+	constexpr FieldDescriptor<Object, Member, Getter, Setter> field(Member Object::* member, Getter get, Setter set)
+	{
+		return { member, get, set };
+	}
+
+	//The fields of T that are synced one to one with its native type (specialise with a
+	//constexpr static tuple of FieldDescriptor named fields).
+	//Anything more involved than a getter/setter pair still needs a ReadSyncer etc. of its own.
+	template<typename T>
+	struct field_table
+	{
+		constexpr static std::tuple<> fields{};
+	};
+
+	template<typename Member>
+	struct field_traits
+	{
+		constexpr static bool reference = false;
+	};
+	template<typename T>
+	struct field_traits<Property<T>>
+	{
+		using value_type = T;
+		constexpr static bool reference = false;
+	};
+	template<typename T>
+	struct field_traits<Ref<T>>
+	{
+		using target_type = T;
+		constexpr static bool reference = true;
+		constexpr static bool strong = true;
+	};
+	template<typename T>
+	struct field_traits<Ptr<T>>
+	{
+		using target_type = T;
+		constexpr static bool reference = true;
+		constexpr static bool strong = false;
+	};
+
+	//The type a native setter takes
+	template<typename Setter> struct setter_arg;
+	template<typename C, typename A>
+	struct setter_arg<void (C::*)(A)> { using type = std::decay_t<A>; };
+	template<typename Setter>
+	using setter_arg_t = typename setter_arg<Setter>::type;
+
+	//Calls f with each FieldDescriptor of T, in order. Unrolls completely.
+	template<typename T, typename Fcn>
+	void forEachField(Fcn&& f)
+	{
+		std::apply([&f](const auto&... fields) { (f(fields), ...); }, field_table<T>::fields);
+	}
+
+	template<typename T>
+	bool readFields(T& object, const typename type_map<T>::type* native, File& file)
+	{
+		forEachField<T>([&](const auto& field)
+			{
+				auto&& member = object.*field.member;
+				using traits = field_traits<std::decay_t<decltype(member)>>;
+
+				if constexpr (traits::reference) {
+					auto target = file.get<typename traits::target_type>((native->*field.get)());
+					if constexpr (!traits::strong)
+						file.keepAlive(target);
+					member.assign(target);
+				}
+				else
+					member.set(nif_type_conversion<typename traits::value_type>::from((native->*field.get)()));
+			});
+		return true;
+	}
+
+	template<typename T>
+	bool writeFields(const T& object, typename type_map<T>::type* native, const File& file)
+	{
+		forEachField<T>([&](const auto& field)
+			{
+				auto&& member = object.*field.member;
+				using traits = field_traits<std::decay_t<decltype(member)>>;
+
+				if constexpr (traits::reference)
+					(native->*field.set)(file.getNative<typename traits::target_type>(member.assigned().get()));
+				else
+					(native->*field.set)(nif_type_conversion<setter_arg_t<decltype(field.set)>>::from(member.view()));
+			});
+		return true;
+	}
+
+	template<typename T>
+	bool subscribeFields(T& object, ChangeTracker& tracker)
+	{
+		forEachField<T>([&](const auto& field) { tracker.subscribe(object.*field.member); });
+		return true;
+	}
+}
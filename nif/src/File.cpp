@@ -19,6 +19,18 @@
 #include "pch.h"
 #include "File.h"
 #include "File.inl"
+#include "MappedFile.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <memory_resource>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
 
 #ifdef _DEBUG
 int g_downwardsPtrs = 0;
@@ -26,8 +38,87 @@ int g_downwardsPtrs = 0;
 
 using namespace nif;
 
+namespace
+{
+	//Allocates from a shared memory resource, and keeps it alive for as long as it has to.
+	//allocate_shared keeps a copy of its allocator until the control block has been deallocated,
+	//so a File's arena will outlive the last of its objects.
+	template<typename T>
+	class ArenaAllocator
+	{
+		template<typename U> friend class ArenaAllocator;
+
+	public:
+		using value_type = T;
+
+		ArenaAllocator(const std::shared_ptr<std::pmr::memory_resource>& arena) noexcept : m_arena{ arena } {}
+		template<typename U>
+		ArenaAllocator(const ArenaAllocator<U>& other) noexcept : m_arena{ other.m_arena } {}
+
+		T* allocate(size_t n)
+		{
+			return static_cast<T*>(m_arena->allocate(n * sizeof(T), alignof(T)));
+		}
+		void deallocate(T* p, size_t n) noexcept
+		{
+			m_arena->deallocate(p, n * sizeof(T), alignof(T));
+		}
+
+		template<typename U>
+		bool operator==(const ArenaAllocator<U>& other) const noexcept { return m_arena == other.m_arena; }
+		template<typename U>
+		bool operator!=(const ArenaAllocator<U>& other) const noexcept { return m_arena != other.m_arena; }
+
+	private:
+		std::shared_ptr<std::pmr::memory_resource> m_arena;
+	};
+
+	//Our objects may be released on any thread (e.g. by a background save), so the arena must be synchronised
+	std::shared_ptr<std::pmr::memory_resource> makeArena()
+	{
+		return std::make_shared<std::pmr::synchronized_pool_resource>();
+	}
+
+	//A graph smaller than this is read on one thread, it's not worth starting any others
+	constexpr size_t PARALLEL_LOAD_MIN = 256;
+
+	//The Niflib type that a field of type Field can refer to, or null if it refers to nothing
+	template<typename Field>
+	struct reference_target
+	{
+		static const Niflib::Type* type() { return nullptr; }
+	};
+	template<typename T>
+	struct reference_target<Set<T>>
+	{
+		static const Niflib::Type* type() { return &type_map<T>::type::TYPE; }
+	};
+	template<typename T>
+	struct reference_target<Sequence<T>>
+	{
+		static const Niflib::Type* type() { return &type_map<T>::type::TYPE; }
+	};
+	template<typename T>
+	struct reference_target<Assignable<T>>
+	{
+		static const Niflib::Type* type() { return &type_map<T>::type::TYPE; }
+	};
+
+	//True if any of Fields could refer to an object of type type
+	template<typename... Fields>
+	bool isReferable(const Niflib::Type& type, detail::type_list<Fields...>)
+	{
+		const Niflib::Type* targets[] = { reference_target<Fields>::type()... };
+		for (const Niflib::Type* target : targets) {
+			if (target && type.IsDerivedType(*target))
+				return true;
+		}
+		return false;
+	}
+}
+
 template<typename T>
-inline File::ObjectPair File::make_NiObject(const Niflib::Ref<Niflib::NiObject>& native)
+inline File::ObjectPair File::make_NiObject(const Niflib::Ref<Niflib::NiObject>& native, File& file)
 {
 	//We will be returning two shared_ptrs to the same resource, but aliased to different members.
 	//One member is an object of type T, the other is a Niflib::Ref to a Niflib::NiObject.
@@ -35,13 +126,15 @@ inline File::ObjectPair File::make_NiObject(const Niflib::Ref<Niflib::NiObject>&
 	//This is safe since we know that the resource that the shared_ptr is managing keeps a 
 	//Niflib::Ref to the object it is pointing to.
 
+	//The tracker listens to the fields of object, so it must be destroyed after it
 	struct NiObjectBlock
 	{
 		Niflib::Ref<Niflib::NiObject> native;
+		ChangeTracker tracker;
 		T object;
 	};
 
-	auto block = std::make_shared<NiObjectBlock>();
+	auto block = std::allocate_shared<NiObjectBlock>(ArenaAllocator<NiObjectBlock>(file.m_arena));
 	if (native) {
 		assert(native->IsDerivedType(type_map<T>::type::TYPE));//Or we are mapped incorrectly
 		block->native = native;
@@ -49,6 +142,9 @@ inline File::ObjectPair File::make_NiObject(const Niflib::Ref<Niflib::NiObject>&
 	else
 		block->native = new typename type_map<T>::type();
 
+	block->tracker.attach(&block->object, file.m_journal);
+	ChangeSubscriber<T>{}.down(block->object, block->tracker);
+
 	return { std::shared_ptr<NiObject>(block, &block->object),
 		std::shared_ptr<Niflib::NiObject>(block, block->native) };
 }
@@ -105,62 +201,127 @@ template<> [[nodiscard]] std::shared_ptr<NiExtraData> File::create() { return ma
 template<> [[nodiscard]] std::shared_ptr<NiStringExtraData> File::create() { return make_ni<NiStringExtraData>(nullptr); }
 template<> [[nodiscard]] std::shared_ptr<NiStringsExtraData> File::create() { return make_ni<NiStringsExtraData>(nullptr); }
 
-std::map<size_t, nif::File::CreateFcn> nif::File::s_typeRegistry;
-void nif::File::registerTypes()
+namespace
 {
-	s_typeRegistry[std::hash<const Niflib::Type*>{}(&Niflib::NiObject::TYPE)] = &make_NiObject<nif::NiObject>;
-	s_typeRegistry[std::hash<const Niflib::Type*>{}(&Niflib::NiObjectNET::TYPE)] = &make_NiObject<nif::NiObjectNET>;
-
-	s_typeRegistry[std::hash<const Niflib::Type*>{}(&Niflib::NiAVObject::TYPE)] = &make_NiObject<nif::NiAVObject>;
-	s_typeRegistry[std::hash<const Niflib::Type*>{}(&Niflib::NiNode::TYPE)] = &make_NiObject<nif::NiNode>;
-	s_typeRegistry[std::hash<const Niflib::Type*>{}(&Niflib::NiBillboardNode::TYPE)] = &make_NiObject<nif::NiBillboardNode>;
-	s_typeRegistry[std::hash<const Niflib::Type*>{}(&Niflib::BSFadeNode::TYPE)] = &make_NiObject<nif::BSFadeNode>;
-
-	s_typeRegistry[std::hash<const Niflib::Type*>{}(&Niflib::NiProperty::TYPE)] = &make_NiObject<nif::NiProperty>;
-	s_typeRegistry[std::hash<const Niflib::Type*>{}(&Niflib::NiAlphaProperty::TYPE)] = &make_NiObject<nif::NiAlphaProperty>;
-	s_typeRegistry[std::hash<const Niflib::Type*>{}(&Niflib::BSShaderProperty::TYPE)] = &make_NiObject<nif::BSShaderProperty>;
-	s_typeRegistry[std::hash<const Niflib::Type*>{}(&Niflib::BSEffectShaderProperty::TYPE)] = &make_NiObject<nif::BSEffectShaderProperty>;
-
-	s_typeRegistry[std::hash<const Niflib::Type*>{}(&Niflib::NiBoolData::TYPE)] = &make_NiObject<nif::NiBoolData>;
-	s_typeRegistry[std::hash<const Niflib::Type*>{}(&Niflib::NiFloatData::TYPE)] = &make_NiObject<nif::NiFloatData>;
-
-	s_typeRegistry[std::hash<const Niflib::Type*>{}(&Niflib::NiInterpolator::TYPE)] = &make_NiObject<nif::NiInterpolator>;
-	s_typeRegistry[std::hash<const Niflib::Type*>{}(&Niflib::NiBoolInterpolator::TYPE)] = &make_NiObject<nif::NiBoolInterpolator>;
-	s_typeRegistry[std::hash<const Niflib::Type*>{}(&Niflib::NiFloatInterpolator::TYPE)] = &make_NiObject<nif::NiFloatInterpolator>;
-
-	s_typeRegistry[std::hash<const Niflib::Type*>{}(&Niflib::NiBlendInterpolator::TYPE)] = &make_NiObject<nif::NiBlendInterpolator>;
-	s_typeRegistry[std::hash<const Niflib::Type*>{}(&Niflib::NiBlendBoolInterpolator::TYPE)] = &make_NiObject<nif::NiBlendBoolInterpolator>;
-	s_typeRegistry[std::hash<const Niflib::Type*>{}(&Niflib::NiBlendFloatInterpolator::TYPE)] = &make_NiObject<nif::NiBlendFloatInterpolator>;
-
-	s_typeRegistry[std::hash<const Niflib::Type*>{}(&Niflib::NiTimeController::TYPE)] = &make_NiObject<nif::NiTimeController>;
-	s_typeRegistry[std::hash<const Niflib::Type*>{}(&Niflib::NiSingleInterpController::TYPE)] = &make_NiObject<nif::NiSingleInterpController>;
-
-	s_typeRegistry[std::hash<const Niflib::Type*>{}(&Niflib::NiParticleSystem::TYPE)] = &make_NiObject<nif::NiParticleSystem>;
-	s_typeRegistry[std::hash<const Niflib::Type*>{}(&Niflib::NiPSysData::TYPE)] = &make_NiObject<nif::NiPSysData>;
+	//Maps Niflib types to the factory of the most derived type that we have registered for them.
+	//Lock free, so that several files can be loaded at once. Entries are never removed, since
+	//Niflib types are static. If it fills up we just stop caching.
+	template<typename Fcn, size_t N>
+	class FactoryCache
+	{
+		static_assert((N & (N - 1)) == 0);
+
+	public:
+		Fcn find(const Niflib::Type* type) const
+		{
+			for (size_t i = hash(type), n = 0; n < N; i = (i + 1) & (N - 1), n++) {
+				const Niflib::Type* key = m_keys[i].load(std::memory_order_acquire);
+				if (key == type)
+					//may still be null if another thread is inserting it
+					return m_values[i].load(std::memory_order_acquire);
+				else if (!key)
+					break;
+			}
+			return nullptr;
+		}
 
-	s_typeRegistry[std::hash<const Niflib::Type*>{}(&Niflib::NiPSysModifier::TYPE)] = &make_NiObject<nif::NiPSysModifier>;
-	s_typeRegistry[std::hash<const Niflib::Type*>{}(&Niflib::NiPSysBoundUpdateModifier::TYPE)] = &make_NiObject<nif::NiPSysBoundUpdateModifier>;
-	s_typeRegistry[std::hash<const Niflib::Type*>{}(&Niflib::NiPSysAgeDeathModifier::TYPE)] = &make_NiObject<nif::NiPSysAgeDeathModifier>;
-	s_typeRegistry[std::hash<const Niflib::Type*>{}(&Niflib::NiPSysPositionModifier::TYPE)] = &make_NiObject<nif::NiPSysPositionModifier>;
-	s_typeRegistry[std::hash<const Niflib::Type*>{}(&Niflib::NiPSysGravityModifier::TYPE)] = &make_NiObject<nif::NiPSysGravityModifier>;
-	s_typeRegistry[std::hash<const Niflib::Type*>{}(&Niflib::NiPSysRotationModifier::TYPE)] = &make_NiObject<nif::NiPSysRotationModifier>;
-	s_typeRegistry[std::hash<const Niflib::Type*>{}(&Niflib::BSPSysScaleModifier::TYPE)] = &make_NiObject<nif::BSPSysScaleModifier>;
-	s_typeRegistry[std::hash<const Niflib::Type*>{}(&Niflib::BSPSysSimpleColorModifier::TYPE)] = &make_NiObject<nif::BSPSysSimpleColorModifier>;
+		void insert(const Niflib::Type* type, Fcn fcn)
+		{
+			for (size_t i = hash(type), n = 0; n < N; i = (i + 1) & (N - 1), n++) {
+				const Niflib::Type* expected = nullptr;
+				if (m_keys[i].compare_exchange_strong(expected, type, std::memory_order_acq_rel) || expected == type) {
+					m_values[i].store(fcn, std::memory_order_release);
+					break;
+				}
+			}
+		}
 
-	s_typeRegistry[std::hash<const Niflib::Type*>{}(&Niflib::NiPSysEmitter::TYPE)] = &make_NiObject<nif::NiPSysEmitter>;
-	s_typeRegistry[std::hash<const Niflib::Type*>{}(&Niflib::NiPSysVolumeEmitter::TYPE)] = &make_NiObject<nif::NiPSysVolumeEmitter>;
-	s_typeRegistry[std::hash<const Niflib::Type*>{}(&Niflib::NiPSysBoxEmitter::TYPE)] = &make_NiObject<nif::NiPSysBoxEmitter>;
-	s_typeRegistry[std::hash<const Niflib::Type*>{}(&Niflib::NiPSysCylinderEmitter::TYPE)] = &make_NiObject<nif::NiPSysCylinderEmitter>;
-	s_typeRegistry[std::hash<const Niflib::Type*>{}(&Niflib::NiPSysSphereEmitter::TYPE)] = &make_NiObject<nif::NiPSysSphereEmitter>;
+	private:
+		static size_t hash(const Niflib::Type* type)
+		{
+			return (reinterpret_cast<std::uintptr_t>(type) >> 4) & (N - 1);
+		}
 
-	s_typeRegistry[std::hash<const Niflib::Type*>{}(&Niflib::NiPSysUpdateCtlr::TYPE)] = &make_NiObject<nif::NiPSysUpdateCtlr>;
-	s_typeRegistry[std::hash<const Niflib::Type*>{}(&Niflib::NiPSysModifierCtlr::TYPE)] = &make_NiObject<nif::NiPSysModifierCtlr>;
-	s_typeRegistry[std::hash<const Niflib::Type*>{}(&Niflib::NiPSysEmitterCtlr::TYPE)] = &make_NiObject<nif::NiPSysEmitterCtlr>;
-	s_typeRegistry[std::hash<const Niflib::Type*>{}(&Niflib::NiPSysGravityStrengthCtlr::TYPE)] = &make_NiObject<nif::NiPSysGravityStrengthCtlr>;
+	private:
+		std::atomic<const Niflib::Type*> m_keys[N]{};
+		std::atomic<Fcn> m_values[N]{};
+	};
+}
 
-	s_typeRegistry[std::hash<const Niflib::Type*>{}(&Niflib::NiExtraData::TYPE)] = &make_NiObject<nif::NiExtraData>;
-	s_typeRegistry[std::hash<const Niflib::Type*>{}(&Niflib::NiStringExtraData::TYPE)] = &make_NiObject<nif::NiStringExtraData>;
-	s_typeRegistry[std::hash<const Niflib::Type*>{}(&Niflib::NiStringsExtraData::TYPE)] = &make_NiObject<nif::NiStringsExtraData>;
+nif::File::CreateFcn nif::File::getFactory(const Niflib::Type& type)
+{
+	//Dense table of the types we care about, built without any registration step
+	static const std::pair<const Niflib::Type*, CreateFcn> registry[] = {
+		{ &Niflib::NiObject::TYPE, &make_NiObject<nif::NiObject> },
+		{ &Niflib::NiObjectNET::TYPE, &make_NiObject<nif::NiObjectNET> },
+
+		{ &Niflib::NiAVObject::TYPE, &make_NiObject<nif::NiAVObject> },
+		{ &Niflib::NiNode::TYPE, &make_NiObject<nif::NiNode> },
+		{ &Niflib::NiBillboardNode::TYPE, &make_NiObject<nif::NiBillboardNode> },
+		{ &Niflib::BSFadeNode::TYPE, &make_NiObject<nif::BSFadeNode> },
+
+		{ &Niflib::NiProperty::TYPE, &make_NiObject<nif::NiProperty> },
+		{ &Niflib::NiAlphaProperty::TYPE, &make_NiObject<nif::NiAlphaProperty> },
+		{ &Niflib::BSShaderProperty::TYPE, &make_NiObject<nif::BSShaderProperty> },
+		{ &Niflib::BSEffectShaderProperty::TYPE, &make_NiObject<nif::BSEffectShaderProperty> },
+
+		{ &Niflib::NiBoolData::TYPE, &make_NiObject<nif::NiBoolData> },
+		{ &Niflib::NiFloatData::TYPE, &make_NiObject<nif::NiFloatData> },
+
+		{ &Niflib::NiInterpolator::TYPE, &make_NiObject<nif::NiInterpolator> },
+		{ &Niflib::NiBoolInterpolator::TYPE, &make_NiObject<nif::NiBoolInterpolator> },
+		{ &Niflib::NiFloatInterpolator::TYPE, &make_NiObject<nif::NiFloatInterpolator> },
+
+		{ &Niflib::NiBlendInterpolator::TYPE, &make_NiObject<nif::NiBlendInterpolator> },
+		{ &Niflib::NiBlendBoolInterpolator::TYPE, &make_NiObject<nif::NiBlendBoolInterpolator> },
+		{ &Niflib::NiBlendFloatInterpolator::TYPE, &make_NiObject<nif::NiBlendFloatInterpolator> },
+
+		{ &Niflib::NiTimeController::TYPE, &make_NiObject<nif::NiTimeController> },
+		{ &Niflib::NiSingleInterpController::TYPE, &make_NiObject<nif::NiSingleInterpController> },
+
+		{ &Niflib::NiParticleSystem::TYPE, &make_NiObject<nif::NiParticleSystem> },
+		{ &Niflib::NiPSysData::TYPE, &make_NiObject<nif::NiPSysData> },
+
+		{ &Niflib::NiPSysModifier::TYPE, &make_NiObject<nif::NiPSysModifier> },
+		{ &Niflib::NiPSysBoundUpdateModifier::TYPE, &make_NiObject<nif::NiPSysBoundUpdateModifier> },
+		{ &Niflib::NiPSysAgeDeathModifier::TYPE, &make_NiObject<nif::NiPSysAgeDeathModifier> },
+		{ &Niflib::NiPSysPositionModifier::TYPE, &make_NiObject<nif::NiPSysPositionModifier> },
+		{ &Niflib::NiPSysGravityModifier::TYPE, &make_NiObject<nif::NiPSysGravityModifier> },
+		{ &Niflib::NiPSysRotationModifier::TYPE, &make_NiObject<nif::NiPSysRotationModifier> },
+		{ &Niflib::BSPSysScaleModifier::TYPE, &make_NiObject<nif::BSPSysScaleModifier> },
+		{ &Niflib::BSPSysSimpleColorModifier::TYPE, &make_NiObject<nif::BSPSysSimpleColorModifier> },
+
+		{ &Niflib::NiPSysEmitter::TYPE, &make_NiObject<nif::NiPSysEmitter> },
+		{ &Niflib::NiPSysVolumeEmitter::TYPE, &make_NiObject<nif::NiPSysVolumeEmitter> },
+		{ &Niflib::NiPSysBoxEmitter::TYPE, &make_NiObject<nif::NiPSysBoxEmitter> },
+		{ &Niflib::NiPSysCylinderEmitter::TYPE, &make_NiObject<nif::NiPSysCylinderEmitter> },
+		{ &Niflib::NiPSysSphereEmitter::TYPE, &make_NiObject<nif::NiPSysSphereEmitter> },
+
+		{ &Niflib::NiPSysUpdateCtlr::TYPE, &make_NiObject<nif::NiPSysUpdateCtlr> },
+		{ &Niflib::NiPSysModifierCtlr::TYPE, &make_NiObject<nif::NiPSysModifierCtlr> },
+		{ &Niflib::NiPSysEmitterCtlr::TYPE, &make_NiObject<nif::NiPSysEmitterCtlr> },
+		{ &Niflib::NiPSysGravityStrengthCtlr::TYPE, &make_NiObject<nif::NiPSysGravityStrengthCtlr> },
+
+		{ &Niflib::NiExtraData::TYPE, &make_NiObject<nif::NiExtraData> },
+		{ &Niflib::NiStringExtraData::TYPE, &make_NiObject<nif::NiStringExtraData> },
+		{ &Niflib::NiStringsExtraData::TYPE, &make_NiObject<nif::NiStringsExtraData> },
+	};
+	static FactoryCache<CreateFcn, 512> cache;
+
+	if (CreateFcn fcn = cache.find(&type))
+		return fcn;
+
+	//If we step up through the inheritance chain of type, the first one we find 
+	//in our registry is the most derived type that we care about.
+	for (const Niflib::Type* t = &type; t; t = t->base_type) {
+		for (auto&& entry : registry) {
+			if (entry.first == t) {
+				cache.insert(&type, entry.second);
+				return entry.second;
+			}
+		}
+	}
+	return nullptr;
 }
 
 namespace Niflib
@@ -168,19 +329,46 @@ namespace Niflib
 	NiObjectRef FindRoot(std::vector<NiObjectRef> const& objects);
 }
 
-nif::File::File(Version version) : m_version{ version }
+void nif::initNiflib()
+{
+	static std::once_flag once;
+	std::call_once(once, []()
+		{
+			Niflib::NifInfo fileInfo;
+			fileInfo.version = 0x14020007;
+			fileInfo.userVersion = 12;
+			fileInfo.userVersion2 = 100;
+
+			std::stringstream s;
+			Niflib::NiObjectRef root = new Niflib::NiNode;
+			Niflib::WriteNifTree(s, root, fileInfo);
+			Niflib::ReadNifList(s);
+		});
+}
+
+nif::File::File(Version version) :
+	m_version{ version }, m_journal{ std::make_shared<ChangeJournal>() }, m_arena{ makeArena() }
 {
 	m_rootNode = create<BSFadeNode>();
 	m_rootNode->flags.raise(14);
 }
 
-nif::File::File(const std::filesystem::path& path)
+nif::File::File(const std::filesystem::path& path, unsigned int threads) :
+	m_journal{ std::make_shared<ChangeJournal>() }, m_arena{ makeArena() }
 {
 	if (!path.empty()) {
-		std::ifstream in(path, std::ifstream::binary);
+		//We may be one of several files being read at once
+		initNiflib();
+
+		//Let Niflib read the header and blocks straight from a mapping of the file.
+		//The bytes are never copied into a stream buffer. We don't decode anything ourselves: every
+		//object needs its Niflib object to be written, so Niflib might as well fill it.
+		MappedFile mapped(path);//may throw
+
+		MemoryStreamBuf buf(mapped.data(), mapped.size());
+		std::istream in(&buf);
 		Niflib::NifInfo fileInfo;
 		auto objects = Niflib::ReadNifList(in, &fileInfo);
-		in.close();
 
 		if (fileInfo.version == 0x14020007 && fileInfo.userVersion == 12) {
 			if (fileInfo.userVersion2 == 83)
@@ -189,8 +377,11 @@ nif::File::File(const std::filesystem::path& path)
 				m_version = Version::SKYRIM_SE;
 		}
 
+		//Everything we read is already in sync
+		ChangeJournal::Suspension suspension(*m_journal);
+
 		if (auto node = Niflib::DynamicCast<Niflib::NiNode>(Niflib::FindRoot(objects)))
-			m_rootNode = make_ni<NiNode>(node);
+			m_rootNode = load(node, threads);
 
 		//All objects should have strong refs by now; empty the temp storage
 		m_tmpStorage.clear();
@@ -199,41 +390,599 @@ nif::File::File(const std::filesystem::path& path)
 
 nif::File::~File()
 {
+	//Snapshots released from now on destroy their own copies
+	std::vector<std::shared_ptr<NiNode>> roots;
+	{
+		std::lock_guard<std::mutex> lock(m_released->lock);
+		m_released->open = false;
+		roots.swap(m_released->roots);
+	}
+}
+
+std::shared_ptr<NiNode> nif::File::load(const Niflib::Ref<Niflib::NiNode>& root, unsigned int threads)
+{
+	assert(root);
+
+	if (threads == 0)
+		threads = std::max(std::thread::hardware_concurrency(), 1u);
+	if (threads == 1)
+		return make_ni<NiNode>(root);
+
+	//Number every Niflib object we can reach, and note what they refer to
+	std::unordered_map<const Niflib::NiObject*, int> numbers;
+	std::vector<Niflib::NiObject*> natives;
+	std::vector<std::vector<int>> refs;
+	std::vector<std::vector<int>> ptrs;
+	auto number = [&numbers, &natives](Niflib::NiObject* native)
+	{
+		auto result = numbers.emplace(native, static_cast<int>(natives.size()));
+		if (result.second)
+			natives.push_back(native);
+		return result.first->second;
+	};
+
+	number(static_cast<Niflib::NiObject*>(root));
+	for (size_t i = 0; i < natives.size(); i++) {
+		std::vector<int> strong;
+		for (auto&& ref : natives[i]->GetRefs())
+			if (ref)
+				strong.push_back(number(static_cast<Niflib::NiObject*>(ref)));
+		refs.push_back(std::move(strong));
+
+		std::vector<int> weak;
+		for (Niflib::NiObject* ptr : natives[i]->GetPtrs())
+			if (ptr)
+				weak.push_back(number(ptr));
+		ptrs.push_back(std::move(weak));
+	}
+
+	//make_ni only creates what our fields refer to. We do the same, so we must not follow references
+	//that none of our fields could hold (geometry, skinning...), or anything only they lead to.
+	std::vector<bool> modelled(natives.size(), false);
+	size_t modelledCount = 1;
+	{
+		std::unordered_map<const Niflib::Type*, bool> referable;
+		auto canHold = [&referable](const Niflib::NiObject* native)
+		{
+			const Niflib::Type& type = native->GetType();
+			auto result = referable.try_emplace(&type, false);
+			if (result.second)
+				result.first->second = isReferable(type, detail::TrackedFields{});
+			return result.first->second;
+		};
+
+		modelled[0] = true;
+		std::vector<int> stack{ 0 };
+		while (!stack.empty()) {
+			int i = stack.back();
+			stack.pop_back();
+			for (const std::vector<int>* targets : { &refs[i], &ptrs[i] }) {
+				for (int target : *targets) {
+					if (!modelled[target] && canHold(natives[target])) {
+						modelled[target] = true;
+						modelledCount++;
+						stack.push_back(target);
+					}
+				}
+			}
+		}
+	}
+
+	if (modelledCount < PARALLEL_LOAD_MIN)
+		return make_ni<NiNode>(root);
+
+	//Split the graph into regions that the workers can sync without touching each other's objects.
+	//The root's subtrees are the regions (or the subtrees of the first object below it with more
+	//than one). Objects that more than one region can reach belong to none of them.
+	constexpr int NONE = -1;
+	constexpr int SERIAL = 0;
+	std::vector<int> region(natives.size(), NONE);
+	region[0] = SERIAL;
+
+	int regions = 1;
+	std::vector<int> seeds;
+	auto split = [&](int i)
+	{
+		regions = 1;
+		seeds.clear();
+		for (int target : refs[i]) {
+			if (region[target] == NONE) {
+				region[target] = regions++;
+				seeds.push_back(target);
+			}
+		}
+	};
+	split(0);
+	while (seeds.size() == 1) {
+		int only = seeds.front();
+		region[only] = SERIAL;
+		split(only);
+	}
+
+	std::vector<int> stack;
+	for (int seed : seeds) {
+		stack.push_back(seed);
+		while (!stack.empty()) {
+			int i = stack.back();
+			stack.pop_back();
+			for (int target : refs[i]) {
+				if (region[target] == NONE || (region[target] != region[i] && region[target] != SERIAL)) {
+					region[target] = region[target] == NONE ? region[i] : SERIAL;
+					stack.push_back(target);
+				}
+			}
+		}
+	}
+
+	//Reading an object touches the Niflib reference count of everything it refers to, which is
+	//not thread safe. Anything that refers outside its own region is synced afterwards, on this thread.
+	std::vector<std::vector<int>> work(regions);
+	std::vector<int> serial;
+	for (size_t i = 0; i < natives.size(); i++) {
+		if (region[i] == NONE)
+			//only reachable through a Ptr
+			region[i] = SERIAL;
+	}
+	for (size_t i = 0; i < natives.size(); i++) {
+		if (!modelled[i])
+			continue;
+
+		bool local = region[i] != SERIAL;
+		for (int target : refs[i])
+			local = local && region[target] == region[i];
+		for (int target : ptrs[i])
+			local = local && region[target] == region[i];
+
+		if (local)
+			work[region[i]].push_back(static_cast<int>(i));
+		else
+			serial.push_back(static_cast<int>(i));
+	}
+
+	//Create everything our fields can refer to up front, so that the workers only ever look objects up.
+	//The index is not modified again until they are done. We hold all of them until then, like
+	//keepAlive would.
+	std::vector<std::shared_ptr<NiObject>> objects(natives.size());
+	{
+		ObservableArena arena(m_arena);
+		for (size_t i = 0; i < natives.size(); i++) {
+			if (modelled[i]) {
+				//NiObject is registered, so there is a factory for every type
+				auto pair = getFactory(natives[i]->GetType())(natives[i], *this);
+				assert(pair.first && pair.second);
+
+				m_index.insert(pair.first, pair.second.get());
+				objects[i] = std::move(pair.first);
+			}
+		}
+	}
+
+	auto sync = [this, &objects](const std::vector<int>& indices)
+	{
+		ObservableArena arena(m_arena);
+		//The fix-up runs on the caller's thread, which may have a batch open
+		ChangeBatch batch(ChangeBatch::Isolated{});
+		NonForwardingReadSyncer syncer(*this);
+		for (int i : indices)
+			objects[i]->dispatch(syncer);
+	};
+
+	//Largest first, so that no worker is left with a big region at the end
+	work.erase(std::remove_if(work.begin(), work.end(), [](const std::vector<int>& v) { return v.empty(); }), work.end());
+	std::sort(work.begin(), work.end(), [](const std::vector<int>& lhs, const std::vector<int>& rhs) { return lhs.size() > rhs.size(); });
+	threads = static_cast<unsigned int>(std::min<size_t>(threads, work.size()));
+
+	std::atomic<size_t> next{ 0 };
+	std::exception_ptr error;
+	std::mutex errorLock;
+	auto worker = [&]()
+	{
+		try {
+			for (size_t i = next++; i < work.size(); i = next++)
+				sync(work[i]);
+		}
+		catch (...) {
+			std::lock_guard<std::mutex> lock(errorLock);
+			if (!error)
+				error = std::current_exception();
+			//Stop the others from starting anything new
+			next = work.size();
+		}
+	};
+
+	std::vector<std::thread> workers;
+	if (threads > 1) {
+		workers.reserve(threads - 1);
+		for (unsigned int i = 1; i < threads; i++)
+			workers.emplace_back(worker);
+	}
+	//We are a worker too
+	worker();
+	for (auto&& w : workers)
+		w.join();
+
+	if (error)
+		std::rethrow_exception(error);
+
+	//The fix-up: everything that refers across regions
+	sync(serial);
+
+	//A field could have referred to some of what we created, without actually doing so (e.g. a
+	//property of a shape). Those go now, along with their index entries, so that our index holds
+	//the same objects as after a load on one thread. No one has heard of them, so their destruction
+	//is not a change.
+	//downcast safe, root is a NiNode
+	auto result = std::static_pointer_cast<NiNode>(objects.front());
+	std::vector<std::weak_ptr<NiObject>> created(objects.begin(), objects.end());
+	{
+		ChangeJournal::Discarding discarding(*m_journal);
+		objects.clear();
+	}
+	for (size_t i = 0; i < natives.size(); i++) {
+		if (created[i].expired())
+			m_index.erase(natives[i]);
+	}
+#ifdef _DEBUG
+	for (size_t i = 0; i < natives.size(); i++) {
+		const ObjectIndex::Entry* entry = m_index.findNative(natives[i]);
+		assert(!entry || !entry->weak.expired());
+	}
+#endif
+
+	return result;
 }
 
 void nif::File::write(const std::filesystem::path& path)
 {
-	if (m_rootNode && !path.empty()) {
-		if (auto it = m_objectIndex.find(m_rootNode.get()); it != m_objectIndex.end()) {
-			if (auto native = it->second.lock()) {
+	if (!path.empty()) {
+		if (auto job = prepareWrite())
+			job->write(path);
+	}
+}
 
-				ForwardingWriteSyncer syncer(*this);
-				m_rootNode->receive(syncer);
+std::unique_ptr<nif::File::WriteJob> nif::File::prepareWrite()
+{
+	return prepareWrite(Pipeline());
+}
 
-				Niflib::NifInfo fileInfo;
-				switch (m_version) {
-				case Version::SKYRIM:
-					fileInfo.version = 0x14020007;
-					fileInfo.userVersion = 12;
-					fileInfo.userVersion2 = 83;
-					break;
-				case Version::SKYRIM_SE:
-					fileInfo.version = 0x14020007;
-					fileInfo.userVersion = 12;
-					fileInfo.userVersion2 = 100;
-					break;
+std::unique_ptr<nif::File::WriteJob> nif::File::prepareWrite(const Pipeline& pipeline)
+{
+	//Changes held back by a batch have not reached the journal yet
+	assert(!ChangeBatch::active());
+	//The last job is still writing our natives
+	assert(!m_writeState->busy);
+	if (m_writeState->busy)
+		return nullptr;
+
+	std::unique_ptr<WriteJob> job;
+
+	if (m_rootNode) {
+		if (auto native = getNative<NiNode>(m_rootNode.get())) {
+
+			syncDirty(pipeline);
+
+			job.reset(new WriteJob);
+			job->m_version = m_version;
+			job->m_root = static_cast<Niflib::NiObject*>(native);
+			job->m_objects.reserve(m_index.size());
+			m_index.forEachLive([&job](const ObjectIndex::Entry& entry)
+				{
+					if (auto object = entry.weak.lock())
+						job->m_objects.push_back(std::move(object));
+				});
+			job->m_state = m_writeState;
+			job->m_sizeHint = m_writeState->lastSize;
+
+			m_writeState->busy = true;
+#ifdef _DEBUG
+			m_index.forEachLive([this](const ObjectIndex::Entry& entry) { m_writeState->natives.insert(entry.native); });
+#endif
+		}
+	}
+
+	return job;
+}
+
+std::shared_ptr<const nif::File::Snapshot> nif::File::publish()
+{
+	//Changes held back by a batch have not reached the journal yet
+	assert(!ChangeBatch::active());
+	//A WriteJob is writing our natives, and we would be touching them
+	assert(!m_writeState->busy);
+	if (m_writeState->busy)
+		return m_published;
+
+	releaseSnapshots();
+
+	if (!m_rootNode)
+		return nullptr;
+
+	auto rootNative = getNative<NiNode>(m_rootNode.get());
+	if (!rootNative)
+		return nullptr;
+
+	//Objects whose references changed (or that are new)
+	std::set<const NiObject*> relinked;
+	if (m_mirror) {
+		bool complete = m_journal->log().read(m_publishCursor, [this, &relinked](const ChangeRecord& change)
+			{
+				if (change.type == ChangeRecord::DESTROY) {
+					m_unpublished.erase(change.object);
+					relinked.erase(change.object);
+					unlink(change.object);
 				}
-				fileInfo.exportInfo1 = "SVFX Editor";
-				fileInfo.exportInfo2 = "Niflib";
+				else {
+					m_unpublished.insert(change.object);
+					if (change.reference || change.type == ChangeRecord::CREATE)
+						relinked.insert(change.object);
+				}
+			});
+		if (!complete)
+			//We have lost track of what changed. Start over with a new mirror, and copy everything.
+			m_mirror.reset();
+	}
+
+	std::vector<const NiObject*> changed;
+	if (m_mirror) {
+		if (m_unpublished.empty() && m_published)
+			return m_published;
+
+		//We copy by reading our (synced) Niflib objects into the mirror. Objects that are not
+		//dirty have been synced by a write since they changed.
+		DirtyWriteSyncer syncer(*this, *m_journal);
+		std::vector<const NiObject*> dirty(m_journal->dirty().begin(), m_journal->dirty().end());
+		for (const NiObject* object : dirty) {
+			auto entry = m_index.findObject(object);
+			assert(entry);
+			if (auto strong = entry->weak.lock())
+				strong->dispatch(syncer);
+		}
+
+		for (const NiObject* object : relinked)
+			relink(object);
+
+		changed.assign(m_unpublished.begin(), m_unpublished.end());
+	}
+	else {
+		//a file without a root
+		m_mirror = std::make_unique<File>(std::filesystem::path());
+		m_unpublished.clear();
+		m_publishCursor = m_journal->log().cursor();
+
+		m_references.clear();
+		m_referrers.clear();
+		std::vector<NiObject*> visited = syncDirty();
+		for (NiObject* object : visited) {
+			if (m_references.find(object) == m_references.end())
+				relink(object);
+			changed.push_back(object);
+		}
+	}
+
+	//An object that refers to a new copy (by Ref or Ptr) must be copied too, or it would still
+	//refer to the old one. This includes the parents of any changed object, up to the root.
+	std::unordered_set<const NiObject*> copy(changed.begin(), changed.end());
+	std::vector<const NiObject*> pending = changed;
+	while (!pending.empty()) {
+		const NiObject* object = pending.back();
+		pending.pop_back();
+		if (auto it = m_referrers.find(object); it != m_referrers.end()) {
+			for (const NiObject* referrer : it->second) {
+				if (copy.insert(referrer).second)
+					pending.push_back(referrer);
+			}
+		}
+	}
+
+	//Nothing we can reach has changed
+	if (copy.find(m_rootNode.get()) == copy.end() && m_published)
+		return m_published;
+
+	//Unindexed objects are created anew when the mirror reads the graph, the rest are reused.
+	//That includes anything that was attached since the last snapshot.
+	for (const NiObject* object : copy) {
+		auto entry = m_index.findObject(object);
+		assert(entry);
+		m_mirror->m_index.erase(entry->native);
+	}
+
+	std::shared_ptr<Snapshot> snapshot(new Snapshot);
+	snapshot->m_version = m_version;
+	snapshot->m_epoch = m_published ? m_published->m_epoch + 1 : 1;
+	snapshot->m_root = m_mirror->get<NiNode>(rootNative);
+	snapshot->m_released = m_released;
+	m_mirror->m_tmpStorage.clear();
+
+	//Objects we couldn't reach are still unpublished
+	for (const NiObject* object : changed) {
+		auto entry = m_index.findObject(object);
+		assert(entry);
+		auto mirrored = m_mirror->m_index.findNative(entry->native);
+		if (mirrored && !mirrored->weak.expired())
+			m_unpublished.erase(object);
+	}
+	m_published = snapshot;
 
-				std::ofstream out(path, std::ofstream::binary);
-				Niflib::WriteNifTree(out, native.get(), fileInfo);
+	return snapshot;
+}
+
+void nif::File::relink(const NiObject* object)
+{
+	//Objects we have no record of (e.g. attached since the last snapshot, but not changed since
+	//the one before) are relinked along with object
+	std::vector<const NiObject*> pending{ object };
+	while (!pending.empty()) {
+		const NiObject* current = pending.back();
+		pending.pop_back();
+		if (current != object && m_references.find(current) != m_references.end())
+			continue;
+
+		unlink(current);
+
+		auto entry = m_index.findObject(current);
+		assert(entry && entry->native);
+
+		auto&& references = m_references[current];
+		auto link = [&](const Niflib::NiObject* native)
+		{
+			if (auto target = native ? m_index.findNative(native) : nullptr; target && !target->weak.expired()) {
+				references.push_back(target->object);
+				m_referrers[target->object].push_back(current);
+				if (m_references.find(target->object) == m_references.end())
+					pending.push_back(target->object);
+			}
+		};
+		for (auto&& ref : entry->native->GetRefs())
+			link(static_cast<Niflib::NiObject*>(ref));
+		for (Niflib::NiObject* ptr : entry->native->GetPtrs())
+			link(ptr);
+	}
+}
+
+void nif::File::unlink(const NiObject* object)
+{
+	if (auto it = m_references.find(object); it != m_references.end()) {
+		for (const NiObject* target : it->second) {
+			if (auto referrers = m_referrers.find(target); referrers != m_referrers.end()) {
+				auto&& list = referrers->second;
+				if (auto pos = std::find(list.begin(), list.end(), object); pos != list.end()) {
+					*pos = list.back();
+					list.pop_back();
+				}
+				if (list.empty())
+					m_referrers.erase(referrers);
 			}
 		}
+		m_references.erase(it);
 	}
 }
 
+void nif::File::releaseSnapshots()
+{
+	std::vector<std::shared_ptr<NiNode>> roots;
+	{
+		std::lock_guard<std::mutex> lock(m_released->lock);
+		roots.swap(m_released->roots);
+	}
+	//destroyed here, on our thread
+}
+
+nif::File::Snapshot::~Snapshot()
+{
+	if (m_released) {
+		std::lock_guard<std::mutex> lock(m_released->lock);
+		if (m_released->open)
+			m_released->roots.push_back(std::move(m_root));
+	}
+	//else our copies go with us
+}
+
+std::vector<NiObject*> nif::File::syncDirty(const Pipeline& pipeline)
+{
+	//Objects that are not reachable from the root stay dirty until they are
+	DirtyWriteSyncer syncer(*this, *m_journal);
+
+	Pipeline fused = pipeline;
+	fused.add(syncer);
+	fused.run(objects());
+
+	//If the passes changed any references, there may be new objects to sync
+	if (updateObjects())
+		m_objects.traverse(syncer);
+
+	std::vector<NiObject*> visited;
+	visited.reserve(m_objects.size());
+	for (auto&& entry : m_objects)
+		visited.push_back(entry.object);
+	return visited;
+}
+
+const nif::ObjectTable& nif::File::objects()
+{
+	updateObjects();
+	return m_objects;
+}
+
+bool nif::File::updateObjects()
+{
+	bool valid = m_objectsBuilt;
+	bool complete = m_journal->log().read(m_objectsCursor, [&valid](const ChangeRecord& change)
+		{
+			if (change.reference)
+				valid = false;
+		});
+
+	if (!valid || !complete) {
+		if (m_rootNode)
+			m_objects.build(*m_rootNode);
+		else
+			m_objects.clear();
+		m_objectsBuilt = true;
+		return true;
+	}
+	else
+		return false;
+}
+
+nif::File::WriteJob::~WriteJob()
+{
+	if (m_state) {
+		if (m_size)
+			m_state->lastSize = m_size;
+		m_state->busy = false;
+#ifdef _DEBUG
+		m_state->natives.clear();
+#endif
+	}
+}
+
+void nif::File::WriteJob::write(const std::filesystem::path& path)
+{
+	assert(m_root);
+
+	Niflib::NifInfo fileInfo;
+	switch (m_version) {
+	case Version::SKYRIM:
+		fileInfo.version = 0x14020007;
+		fileInfo.userVersion = 12;
+		fileInfo.userVersion2 = 83;
+		break;
+	case Version::SKYRIM_SE:
+		fileInfo.version = 0x14020007;
+		fileInfo.userVersion = 12;
+		fileInfo.userVersion2 = 100;
+		break;
+	}
+	fileInfo.exportInfo1 = "SVFX Editor";
+	fileInfo.exportInfo2 = "Niflib";
+
+	//Niflib writes field by field. Collect it all in memory and write it to disk at once.
+	//Sized from the File's last output, it's unlikely to have to grow.
+	BufferStreamBuf buf(m_sizeHint);
+	{
+		std::ostream out(&buf);
+		Niflib::WriteNifTree(out, m_root, fileInfo);
+		if (!out)
+			throw std::runtime_error("Failed to serialise file");
+	}
+	//The File hears of it when we are destroyed, on its thread
+	m_size = buf.size();
+
+	replaceFile(path, buf.data(), buf.size());
+}
+
 void nif::File::keepAlive(const std::shared_ptr<NiObject>& obj)
 {
+	std::lock_guard<std::mutex> lock(m_tmpLock);
 	m_tmpStorage.push_back(obj);
 }
+
+bool nif::File::isDirty(const NiObject* object) const
+{
+	return m_journal->isDirty(object);
+}
+
+const nif::ChangeLog& nif::File::changes() const
+{
+	return m_journal->log();
+}
@@ -19,16 +19,29 @@
 #pragma once
 #include <filesystem>
 #include <map>
+#include <memory_resource>
+#include <mutex>
 #include <set>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include "nif_objects.h"
+#include "ChangeLog.h"
+#include "ObjectIndex.h"
+#include "ObjectTable.h"
+#include "Pipeline.h"
 
 namespace nif
 {
+	class ChangeJournal;
+
 	class File
 	{
 	public:
+		class WriteJob;
+		class Snapshot;
+
 		//using Version = unsigned int;
 		//constexpr static Version SKYRIM = 0x14020007;
 
@@ -41,11 +54,13 @@ namespace nif
 
 	private:
 		using ObjectPair = std::pair<std::shared_ptr<NiObject>, std::shared_ptr<Niflib::NiObject>>;
-		using CreateFcn = ObjectPair(*)(const Niflib::Ref<Niflib::NiObject>&);
+		using CreateFcn = ObjectPair(*)(const Niflib::Ref<Niflib::NiObject>&, File&);
 
 	public:
 		File(Version version = Version::UNKNOWN);
-		File(const std::filesystem::path& path);
+		//Load the file at path. Parts of the graph that don't refer to each other are read on up to
+		//threads worker threads (0 to use one per hardware thread, 1 to read it all on this thread).
+		File(const std::filesystem::path& path, unsigned int threads = 0);
 
 		File(const File&) = delete;
 		File& operator=(const File&) = delete;
@@ -62,9 +77,28 @@ namespace nif
 		//The the nif version of the file
 		Version getVersion() const { return m_version; }
 
-		//Write the file to the target path
+		//Write the file to the target path.
+		//Only objects that have changed since the last write are synced to Niflib. Niflib serialises
+		//the whole file into memory, which is then written to disk in one go.
+		//Throws std::runtime_error if the file cannot be written, leaving any existing target untouched.
 		void write(const std::filesystem::path& path);
 
+		//Sync our changes to Niflib and return a job that writes the result, e.g. on another thread.
+		//Our objects may be edited (and created or destroyed) while the job runs, but we must not be
+		//written, published or synced in any other way until it is destroyed. Returns null if we have no root.
+		[[nodiscard]] std::unique_ptr<WriteJob> prepareWrite();
+		//As above, but runs the passes of pipeline first, in the same walk as our sync.
+		//Each object is synced after the passes are done with it.
+		[[nodiscard]] std::unique_ptr<WriteJob> prepareWrite(const Pipeline& pipeline);
+
+		//Sync our changes to Niflib and return an immutable copy of our objects, that other threads
+		//can read while we are being edited. Objects that have not changed since the last snapshot
+		//(and refer to nothing that has) are shared with it, so we only copy what changed.
+		//Returns the last snapshot if nothing we can reach has. Same restrictions as prepareWrite,
+		//except that changed objects are synced whether we can reach them or not.
+		//The work done is proportional to what changed, not to the size of the file.
+		//Returns null if we have no root.
+		[[nodiscard]] std::shared_ptr<const Snapshot> publish();
 
 		//These getters should not be part of the public interface, they are nif internal business!
 
@@ -80,33 +114,180 @@ namespace nif
 		template<typename T>
 		[[nodiscard]] Niflib::Ref<typename type_map<T>::type> getNative(T* object) const;
 
+		//Records the changes to our objects. Read syncs outside of a load should happen under a
+		//ChangeJournal::Suspension of it (and an isolated ChangeBatch inside that), like ours do.
+		ChangeJournal& journal() { return *m_journal; }
+
 		//If a file contains downwards Ptrs, they must be kept alive until the whole graph has been synced.
-		//Pass any weak reference to this function during read sync.
+		//Pass any weak reference to this function during read sync. Safe to call from the workers of a load.
 		void keepAlive(const std::shared_ptr<NiObject>& obj);
 
+		//True if object has changed since it was last synced to its Niflib object
+		bool isDirty(const NiObject* object) const;
+
+		//All objects reachable from our root, in forwarding order. Rebuilt if a reference has been
+		//assigned, added or removed since the last call, the entries are good until then.
+		const ObjectTable& objects();
+
+		//Every change to our objects since we were created or loaded (reading is not a change).
+		//Read it through a Cursor to find out what changed since you last looked.
+		const ChangeLog& changes() const;
+
 	private:
 		//Create a new object and add to our index
 		template<typename T>
 		std::shared_ptr<T> make_ni(const Niflib::Ref<typename type_map<T>::type>& native);
 
+		//Create and read sync every object reachable from root, sharing the work between up to
+		//threads threads if the graph is large enough to be worth it.
+		std::shared_ptr<NiNode> load(const Niflib::Ref<Niflib::NiNode>& root, unsigned int threads);
+
+		//Write sync the objects that have changed since the last sync, after running pipeline on them.
+		//Returns every object reachable from the root, in forwarding order, once each.
+		std::vector<NiObject*> syncDirty(const Pipeline& pipeline = Pipeline());
+
+		//Rebuild our object table if it is out of date. Returns true if it was.
+		bool updateObjects();
+
+		//Replace what we have recorded that object refers to with what its (synced) Niflib object
+		//refers to now. Anything it refers to that we have no record of is recorded too.
+		void relink(const NiObject* object);
+		//Forget what object refers to
+		void unlink(const NiObject* object);
+
+		//Destroy the copies of snapshots that have been released since the last call
+		void releaseSnapshots();
+
 	private:
 		//Our factory functions
 		template<typename T>
-		static ObjectPair make_NiObject(const Niflib::Ref<Niflib::NiObject>& native);
+		static ObjectPair make_NiObject(const Niflib::Ref<Niflib::NiObject>& native, File& file);
 
-		//Register factory functions on first use
-		static void registerTypes();
+		//Return the factory function of the most derived type that type maps to.
+		//Cached per type. Safe to call from multiple threads.
+		static CreateFcn getFactory(const Niflib::Type& type);
 
 	private:
-		static std::map<size_t, CreateFcn> s_typeRegistry;
-
 		Version m_version{ Version::UNKNOWN };
 		std::shared_ptr<NiNode> m_rootNode;
 
-		std::map<Niflib::NiObject*, std::weak_ptr<NiObject>> m_nativeIndex;
-		std::map<NiObject*, std::weak_ptr<Niflib::NiObject>> m_objectIndex;
+		ObjectIndex m_index;
 
 		std::vector<std::shared_ptr<NiObject>> m_tmpStorage;
+		std::mutex m_tmpLock;
+
+		//Shared with the trackers of all our objects, which may outlive us
+		std::shared_ptr<ChangeJournal> m_journal;
+
+		//Holds our object blocks and the bookkeeping of their fields.
+		//Shared with the blocks, which may outlive us.
+		std::shared_ptr<std::pmr::memory_resource> m_arena;
+
+		ObjectTable m_objects;
+		bool m_objectsBuilt{ false };
+		ChangeLog::Cursor m_objectsCursor;
+
+		//The copies in our snapshots. Indexes them by the same Niflib objects as we index ours.
+		std::unique_ptr<File> m_mirror;
+		//Keeps the copies of the last snapshot alive, so the mirror can share them with the next
+		std::shared_ptr<const Snapshot> m_published;
+		//Objects that have changed since they were last copied, read from our change log
+		std::set<const NiObject*> m_unpublished;
+		ChangeLog::Cursor m_publishCursor;
+		//What each object refers to (by Ref or Ptr), and what refers to it, as of the last snapshot.
+		//Kept up to date from the change log.
+		std::unordered_map<const NiObject*, std::vector<const NiObject*>> m_references;
+		std::unordered_map<const NiObject*, std::vector<const NiObject*>> m_referrers;
+
+		//Where released snapshots leave their copies, for us to destroy on our thread
+		struct ReleasedSnapshots
+		{
+			std::mutex lock;
+			bool open{ true };//false once we are gone
+			std::vector<std::shared_ptr<NiNode>> roots;
+		};
+		std::shared_ptr<ReleasedSnapshots> m_released{ std::make_shared<ReleasedSnapshots>() };
+
+		//Shared with the job of our last prepareWrite, which lets us know when it is done
+		struct WriteState
+		{
+			//A job exists. The natives it writes must not be touched until it is destroyed.
+			bool busy{ false };
+			//Size of the last output, to serialise the next one without growing the buffer
+			size_t lastSize{ 0 };
+#ifdef _DEBUG
+			//The natives the job holds, to catch anyone touching them
+			std::unordered_set<const Niflib::NiObject*> natives;
+#endif
+		};
+		std::shared_ptr<WriteState> m_writeState{ std::make_shared<WriteState>() };
+	};
+
+	//The state of a File at the time it was prepared for writing.
+	//Can be written from any thread, but must be destroyed on the File's thread (before the File).
+	class File::WriteJob
+	{
+	public:
+		WriteJob(const WriteJob&) = delete;
+		~WriteJob();
+
+		WriteJob& operator=(const WriteJob&) = delete;
+
+		//Serialise to a temporary file next to path, flush it to disk and rename it to path.
+		//Throws std::runtime_error on failure.
+		void write(const std::filesystem::path& path);
+
+	private:
+		friend class File;
+		WriteJob() = default;
+
+	private:
+		Version m_version{ Version::UNKNOWN };
+		Niflib::NiObject* m_root{ nullptr };
+
+		//Niflib's reference counting is not thread safe, and serialising it touches the count of
+		//every object. Editing our objects doesn't touch their natives, but destroying them does.
+		//That includes objects we can't reach, whose natives may still refer to ones we can. So we
+		//keep every object of the File alive until the job is destroyed. Anything else that touches
+		//natives (syncing, publishing) the File refuses to do while we exist.
+		std::vector<std::shared_ptr<NiObject>> m_objects;
+
+		std::shared_ptr<WriteState> m_state;
+		size_t m_sizeHint{ 0 };
+		size_t m_size{ 0 };
+	};
+
+	//The objects of a File as they were when it was published.
+	//Can be read, traversed and released on any thread, but must not be modified. The copies hold
+	//references to Niflib objects, whose counts are not thread safe, so they are handed back to the
+	//File to be destroyed on its next publish (or right away if the File is gone, in which case its
+	//snapshots should not be released concurrently). Pointers taken from a snapshot should be
+	//released before it is.
+	class File::Snapshot
+	{
+	public:
+		Snapshot(const Snapshot&) = delete;
+		~Snapshot();
+
+		Snapshot& operator=(const Snapshot&) = delete;
+
+		//Our copy of the root node
+		std::shared_ptr<NiNode> getRoot() const { return m_root; }
+
+		Version getVersion() const { return m_version; }
+
+		//Increases by one for each snapshot of the File that is published
+		unsigned long long epoch() const { return m_epoch; }
+
+	private:
+		friend class File;
+		Snapshot() = default;
+
+	private:
+		Version m_version{ Version::UNKNOWN };
+		unsigned long long m_epoch{ 0 };
+		std::shared_ptr<NiNode> m_root;
+		std::shared_ptr<ReleasedSnapshots> m_released;
 	};
 
 	//Use explicit specialisation here to avoid the public having to know anything about the native type.
@@ -56,6 +56,19 @@ namespace nif
 		void invoke(T& object);
 	};
 
+	//Write syncs objects that have changed since the last write. Does not forward.
+	class DirtyWriteSyncer final : public HorizontalTraverser<DirtyWriteSyncer>
+	{
+		File& m_file;
+		ChangeJournal& m_journal;
+
+	public:
+		DirtyWriteSyncer(File& file, ChangeJournal& journal) : m_file{ file }, m_journal{ journal } {}
+
+		template<typename T>
+		void invoke(T& object);
+	};
+
 	class NonForwardingReadSyncer final : public HorizontalTraverser<NonForwardingReadSyncer>
 	{
 		File& m_file;
@@ -84,8 +97,8 @@ namespace nif
 		std::shared_ptr<T> result;
 
 		if (nativeRef) {
-			if (auto it = m_nativeIndex.find(static_cast<Niflib::NiObject*>(nativeRef)); it != m_nativeIndex.end()) {
-				if (auto object = it->second.lock()) {
+			if (auto entry = m_index.findNative(static_cast<Niflib::NiObject*>(nativeRef))) {
+				if (auto object = entry->weak.lock()) {
 					//downcast safe if type_map is correct
 					result = std::static_pointer_cast<T>(object);
 				}
@@ -115,10 +128,14 @@ namespace nif
 		Niflib::Ref<typename type_map<T>::type> result;
 
 		if (object) {
-			if (auto it = m_objectIndex.find(object); it != m_objectIndex.end()) {
-				if (auto native = it->second.lock())
+			if (auto entry = m_index.findObject(object)) {
+#ifdef _DEBUG
+				//Touching the count of a native that a WriteJob is writing is a race
+				assert(m_writeState->natives.find(entry->native) == m_writeState->natives.end());
+#endif
+				if (!entry->weak.expired())
 					//We know it can be cast to the native type since we know it was used to create object
-					result = static_cast<typename type_map<T>::type*>(native.get());
+					result = static_cast<typename type_map<T>::type*>(entry->native);
 				else
 					//object is indexed but has expired, so it is dangling. This is a bug.
 					assert(false);
@@ -134,61 +151,41 @@ namespace nif
 	template<typename T>
 	inline std::shared_ptr<T> File::make_ni(const Niflib::Ref<typename type_map<T>::type>& native)
 	{
-		//Our type registry contains all the types that we care about.
-		//If we step up through the inheritance chain of Niflib's type object,
-		//the first one we find in our registry is the most derived type that 
-		//we care about.
-
-		//We must not go higher up than type_map<T>::type, since that should be
-		//the least derived type that maps to T.
-		static bool registered = false;
-		if (!registered) {
-			registerTypes();
-			registered = true;
-		}
-
-		nif::File::CreateFcn fcn = nullptr;
-
-		const Niflib::Type* type = native ? &native->GetType() : &type_map<T>::type::TYPE;
-
-		while (type) {
-			if (auto it = s_typeRegistry.find(std::hash<const Niflib::Type*>{}(type)); it != s_typeRegistry.end()) {
-				fcn = it->second;
-				break;
-			}
-
-			if (type == &type_map<T>::type::TYPE)
-				break;
-			else
-				type = type->base_type;
-		}
-
+		//type_map<T>::type is registered, so the factory we find can never be for a less derived 
+		//type than T (given that native really is derived from type_map<T>::type).
+		assert(!native || native->IsDerivedType(type_map<T>::type::TYPE));
+		CreateFcn fcn = getFactory(native ? native->GetType() : type_map<T>::type::TYPE);
 		assert(fcn);
 
 		//The CreateFcn must guarantee that it creates an object of the type mapped to from
 		//type_map<Y>::type, where Y is the Niflib type associated with the Niflib::Type object
 		//that the CreateFcn is mapped to.
 
-		auto pair = fcn(Niflib::StaticCast<Niflib::NiObject>(native));
+		//Allocate anything the fields of the new object need from our arena, including
+		//when they are filled by the read sync
+		ObservableArena arena(m_arena);
+
+		auto pair = fcn(Niflib::StaticCast<Niflib::NiObject>(native), *this);
 
 		//factory should throw on failure. We won't catch it, we'll typically be part of a longer procedure.
 		assert(pair.first && pair.second);
 
-		if (auto res = m_objectIndex.insert({ pair.first.get(), pair.second }); !res.second) {
-			//The object has already been indexed. Since we just created it, this must be a reused address.
-			//The block must have expired.
-			assert(res.first->second.expired());
-			res.first->second = pair.second;
-		}
-		if (auto res = m_nativeIndex.insert({ pair.second.get(), pair.first }); !res.second) {
-			//if native was created by us, the address has been reused and the block must have expired.
-			assert(!native || res.first->second.expired());
-			res.first->second = pair.first;
+		//If either address is already indexed, it must be reused from an expired block
+		m_index.insert(pair.first, pair.second.get());
+
+		//Make sure the output object is synced to the Niflib object (this is not a change).
+		//The batch is isolated, so that the signals arrive before the suspension ends even if we
+		//are part of a larger batch.
+		{
+			ChangeJournal::Suspension suspension(*m_journal);
+			ChangeBatch batch(ChangeBatch::Isolated{});
+			NonForwardingReadSyncer syncer(*this);
+			pair.first->dispatch(syncer);
 		}
 
-		//Make sure the output object is synced to the Niflib object
-		NonForwardingReadSyncer syncer(*this);
-		pair.first->receive(syncer);
+		//A new object has never been written
+		if (!native)
+			m_journal->created(pair.first.get());
 
 		//downcast safe if type_map is correct
 		return std::static_pointer_cast<T>(pair.first);
@@ -208,6 +205,15 @@ namespace nif
 		Forwarder<T>{}.down(object, *this);
 	}
 
+	template<typename T>
+	inline void DirtyWriteSyncer::invoke(T& object)
+	{
+		if (m_journal.isDirty(&object)) {
+			m_journal.clean(&object);
+			WriteSyncer<T>{}.down(object, m_file.getNative<T>(&object), m_file);
+		}
+	}
+
 	template<typename T>
 	inline void NonForwardingReadSyncer::invoke(T& object)
 	{
@@ -40,7 +40,7 @@ namespace nif
 	{
 	public:
 		virtual ~IListener() = default;
-		void receive(const Event<nif::FlagSet<T>>&e, Observable<nif::FlagSet<T>>&)
+		virtual void receive(const Event<nif::FlagSet<T>>&e, Observable<nif::FlagSet<T>>&)
 		{ 
 			switch (e.type) {
 			case Event<nif::FlagSet<T>>::RAISE:
@@ -0,0 +1,255 @@
+//Copyright 2021 Jonas Gernandt
+//
+//This file is part of SVFX Editor, a program for creating visual effects
+//in the NetImmerse format.
+//
+//SVFX Editor is free software: you can redistribute it and/or modify
+//it under the terms of the GNU General Public License as published by
+//the Free Software Foundation, either version 3 of the License, or
+//(at your option) any later version.
+//
+//SVFX Editor is distributed in the hope that it will be useful,
+//but WITHOUT ANY WARRANTY; without even the implied warranty of
+//MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//GNU General Public License for more details.
+//
+//You should have received a copy of the GNU General Public License
+//along with SVFX Editor. If not, see <https://www.gnu.org/licenses/>.
+
+#include "pch.h"
+#include "Header.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+constexpr unsigned int VER_SKYRIM = 0x14020007;
+constexpr unsigned int USER_VER_SKYRIM = 12;
+constexpr unsigned int BS_VER_SKYRIM = 83;
+constexpr unsigned int BS_VER_SKYRIM_SE = 100;
+
+//The header string is a single line, but we don't want to scan a whole
+//file for a line break if we were given something that isn't a nif.
+constexpr size_t MAX_HEADER_STRING = 128;
+
+namespace
+{
+	//Thrown internally when the buffer runs out. Never leaves this file.
+	struct Truncated {};
+
+	//Little endian reader over a byte buffer
+	class Reader
+	{
+	public:
+		Reader(const char* data, size_t size) : m_begin{ data }, m_pos{ data }, m_end{ data + size } {}
+
+		size_t position() const { return m_pos - m_begin; }
+
+		unsigned char u8()
+		{
+			require(1);
+			return static_cast<unsigned char>(*m_pos++);
+		}
+		unsigned short u16()
+		{
+			require(2);
+			unsigned short result = static_cast<unsigned char>(m_pos[0])
+				| static_cast<unsigned short>(static_cast<unsigned char>(m_pos[1])) << 8;
+			m_pos += 2;
+			return result;
+		}
+		unsigned int u32()
+		{
+			require(4);
+			unsigned int result = static_cast<unsigned char>(m_pos[0])
+				| static_cast<unsigned int>(static_cast<unsigned char>(m_pos[1])) << 8
+				| static_cast<unsigned int>(static_cast<unsigned char>(m_pos[2])) << 16
+				| static_cast<unsigned int>(static_cast<unsigned char>(m_pos[3])) << 24;
+			m_pos += 4;
+			return result;
+		}
+
+		//uint length followed by that many characters
+		std::string sizedString()
+		{
+			unsigned int length = u32();
+			return chars(length);
+		}
+
+		//byte length followed by that many characters, including a null terminator
+		std::string exportString()
+		{
+			unsigned int length = u8();
+			std::string result = chars(length);
+			while (!result.empty() && result.back() == '\0')
+				result.pop_back();
+			return result;
+		}
+
+		std::string line(size_t maxLength)
+		{
+			size_t available = std::min(maxLength, static_cast<size_t>(m_end - m_pos));
+			if (auto eol = static_cast<const char*>(std::memchr(m_pos, '\n', available))) {
+				std::string result(m_pos, eol);
+				m_pos = eol + 1;
+				return result;
+			}
+			else if (available == maxLength)
+				throw std::runtime_error("Not a nif file");
+			else
+				throw Truncated();
+		}
+
+		void skip(size_t bytes)
+		{
+			require(bytes);
+			m_pos += bytes;
+		}
+
+		void require(size_t bytes) const
+		{
+			if (static_cast<size_t>(m_end - m_pos) < bytes)
+				throw Truncated();
+		}
+
+	private:
+		std::string chars(size_t length)
+		{
+			require(length);
+			std::string result(m_pos, length);
+			m_pos += length;
+			return result;
+		}
+
+	private:
+		const char* const m_begin;
+		const char* m_pos;
+		const char* const m_end;
+	};
+
+	//"Gamebryo File Format, Version 20.2.0.7" -> 0x14020007
+	unsigned int parseVersionString(const std::string& s)
+	{
+		size_t pos = s.rfind(' ');
+		if (pos == std::string::npos)
+			return 0;
+
+		unsigned int result = 0;
+		int parts = 0;
+		unsigned int part = 0;
+		for (size_t i = pos + 1; i < s.size(); i++) {
+			if (s[i] == '.') {
+				result = (result << 8) | (part & 0xff);
+				part = 0;
+				parts++;
+			}
+			else if (s[i] >= '0' && s[i] <= '9')
+				part = part * 10 + (s[i] - '0');
+			else
+				return 0;
+		}
+		result = (result << 8) | (part & 0xff);
+		parts++;
+
+		//Old style versions have fewer parts, pad them
+		for (; parts < 4; parts++)
+			result <<= 8;
+
+		return result;
+	}
+}
+
+nif::File::Version nif::Header::fileVersion() const
+{
+	if (version == VER_SKYRIM && userVersion == USER_VER_SKYRIM) {
+		if (bsVersion == BS_VER_SKYRIM)
+			return File::Version::SKYRIM;
+		else if (bsVersion == BS_VER_SKYRIM_SE)
+			return File::Version::SKYRIM_SE;
+	}
+	return File::Version::UNKNOWN;
+}
+
+bool nif::readHeader(const char* data, size_t size, Header& header)
+{
+	assert(data || size == 0);
+
+	Reader in(data, size);
+
+	try {
+		header.headerString = in.line(MAX_HEADER_STRING);
+		if (header.headerString.find("File Format") == std::string::npos)
+			throw std::runtime_error("Not a nif file");
+
+		//We only decode headers that are new enough to have a binary version number,
+		//a block type table and a block type index
+		if (unsigned int ver = parseVersionString(header.headerString); ver < 0x0A000100)
+			throw std::runtime_error("Unsupported nif version");
+
+		header.version = in.u32();
+
+		if (header.version >= 0x14000003)
+			header.littleEndian = in.u8() != 0;
+		if (!header.littleEndian)
+			throw std::runtime_error("Unsupported byte order");
+
+		if (header.version >= 0x0A000108)
+			header.userVersion = in.u32();
+
+		unsigned int numBlocks = in.u32();
+
+		if (header.version == 0x0A000102 || (header.version >= 0x0A010000 && header.userVersion >= 3)) {
+			header.bsVersion = in.u32();
+			header.creator = in.exportString();
+			if (header.bsVersion > 130)
+				in.skip(4);
+			if (header.bsVersion < 131)
+				header.exportInfo1 = in.exportString();
+			header.exportInfo2 = in.exportString();
+			if (header.bsVersion >= 103)
+				in.exportString();//max filepath, not interesting
+		}
+
+		unsigned short numBlockTypes = in.u16();
+		header.blockTypes.resize(numBlockTypes);
+		for (auto&& type : header.blockTypes)
+			type = in.sizedString();
+
+		//Don't trust the block count before we know the data is there
+		size_t tableSize = (header.version >= 0x14020005 ? 6 : 2) * static_cast<size_t>(numBlocks);
+		in.require(tableSize);
+
+		header.blockTypeIndex.resize(numBlocks);
+		for (auto&& index : header.blockTypeIndex) {
+			//The high bit is a flag used by later versions
+			index = in.u16() & 0x7fff;
+			if (index >= numBlockTypes)
+				throw std::runtime_error("Invalid block type index");
+		}
+
+		if (header.version >= 0x14020005) {
+			header.blockSizes.resize(numBlocks);
+			for (auto&& blockSize : header.blockSizes)
+				blockSize = in.u32();
+		}
+
+		if (header.version >= 0x14010001) {
+			unsigned int numStrings = in.u32();
+			in.skip(4);//max string length
+			header.strings.clear();
+			for (unsigned int i = 0; i < numStrings; i++)
+				header.strings.push_back(in.sizedString());
+		}
+
+		if (header.version >= 0x05000006) {
+			unsigned int numGroups = in.u32();
+			in.skip(4 * static_cast<size_t>(numGroups));
+		}
+
+		header.size = in.position();
+		return true;
+	}
+	catch (const Truncated&) {
+		return false;
+	}
+}
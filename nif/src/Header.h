@@ -0,0 +1,63 @@
+//Copyright 2021 Jonas Gernandt
+//
+//This file is part of SVFX Editor, a program for creating visual effects
+//in the NetImmerse format.
+//
+//SVFX Editor is free software: you can redistribute it and/or modify
+//it under the terms of the GNU General Public License as published by
+//the Free Software Foundation, either version 3 of the License, or
+//(at your option) any later version.
+//
+//SVFX Editor is distributed in the hope that it will be useful,
+//but WITHOUT ANY WARRANTY; without even the implied warranty of
+//MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//GNU General Public License for more details.
+//
+//You should have received a copy of the GNU General Public License
+//along with SVFX Editor. If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "File.h"
+
+namespace nif
+{
+	//Everything in a nif file that precedes the first block
+	struct Header
+	{
+		std::string headerString;
+		unsigned int version{ 0 };
+		bool littleEndian{ true };
+		unsigned int userVersion{ 0 };
+		//Called userVersion2 by Niflib
+		unsigned int bsVersion{ 0 };
+
+		//Same names as in Niflib::NifInfo
+		std::string creator;
+		std::string exportInfo1;
+		std::string exportInfo2;
+
+		std::vector<std::string> blockTypes;
+		//Index into blockTypes, one per block
+		std::vector<unsigned short> blockTypeIndex;
+		//Size in bytes, one per block (empty if the version does not store them)
+		std::vector<unsigned int> blockSizes;
+		std::vector<std::string> strings;
+
+		//Number of bytes occupied by the header
+		size_t size{ 0 };
+
+		size_t blockCount() const { return blockTypeIndex.size(); }
+
+		File::Version fileVersion() const;
+	};
+
+	//Decode a header from the start of a buffer, without reading any blocks (see probe).
+	//Loading a File does not use this, Niflib decodes the header along with the blocks.
+	//Returns false if the buffer ends before the header does (more data is needed).
+	//Throws std::runtime_error if the data is not a nif header we can decode.
+	bool readHeader(const char* data, size_t size, Header& header);
+}
@@ -0,0 +1,283 @@
+//Copyright 2021 Jonas Gernandt
+//
+//This file is part of SVFX Editor, a program for creating visual effects
+//in the NetImmerse format.
+//
+//SVFX Editor is free software: you can redistribute it and/or modify
+//it under the terms of the GNU General Public License as published by
+//the Free Software Foundation, either version 3 of the License, or
+//(at your option) any later version.
+//
+//SVFX Editor is distributed in the hope that it will be useful,
+//but WITHOUT ANY WARRANTY; without even the implied warranty of
+//MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//GNU General Public License for more details.
+//
+//You should have received a copy of the GNU General Public License
+//along with SVFX Editor. If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+#include <algorithm>
+#include <cassert>
+#include <type_traits>
+#include <vector>
+#include "Observable.h"
+
+namespace nif
+{
+	enum class KeyColumn
+	{
+		TIME,
+		VALUE,
+		FWD_TAN,
+		BWD_TAN,
+		TENSION,
+		BIAS,
+		CONTINUITY,
+	};
+
+	template<typename T> class KeyTable;
+
+	template<typename T>
+	struct Event<KeyTable<T>>
+	{
+		enum {
+			INSERT,
+			ERASE,
+			MOVE,
+			SET,
+		} type{ INSERT };
+		int pos1{ -1 };
+		int pos2{ -1 };
+		int count{ 1 };//number of keys, for insert/erase/set
+		nif::KeyColumn column{ nif::KeyColumn::TIME };//for set
+	};
+
+	//There are no listeners on individual keys. Anyone interested in a few keys filters
+	//the column events by position.
+	template<typename T>
+	class IListener<KeyTable<T>>
+	{
+	public:
+		virtual ~IListener() = default;
+
+		virtual void receive(const Event<nif::KeyTable<T>>& e, Observable<nif::KeyTable<T>>&)
+		{
+			switch (e.type) {
+			case Event<nif::KeyTable<T>>::INSERT:
+				onInsert(e.pos1, e.count);
+				break;
+			case Event<nif::KeyTable<T>>::ERASE:
+				onErase(e.pos1, e.count);
+				break;
+			case Event<nif::KeyTable<T>>::MOVE:
+				onMove(e.pos1, e.pos2);
+				break;
+			case Event<nif::KeyTable<T>>::SET:
+				onSet(e.column, e.pos1, e.count);
+				break;
+			}
+		}
+
+		//count keys were inserted/erased starting at pos
+		virtual void onInsert(int pos, int count) {}
+		virtual void onErase(int pos, int count) {}
+		virtual void onMove(int from, int to) {}
+		//count values of column were set, starting at pos
+		virtual void onSet(nif::KeyColumn column, int pos, int count) {}
+	};
+	template<typename T> using KeyTableListener = IListener<KeyTable<T>>;
+
+	//Animation keys, stored by column. Times and values are contiguous, so a curve can be read
+	//(or evaluated) without going through a Property per key.
+	//Changes are signalled per column and range, never per key.
+	template<typename T>
+	class KeyTable final : public Observable<KeyTable<T>>
+	{
+	public:
+		using value_type = T;
+
+		template<KeyColumn C>
+		using column_type = std::conditional_t<
+			C == KeyColumn::VALUE || C == KeyColumn::FWD_TAN || C == KeyColumn::BWD_TAN, T, float>;
+
+		//A copy of one key, for when we need to take a key out and put it back
+		struct Row
+		{
+			float time{ 0.0f };
+			T value{ T() };
+			T fwdTan{ T() };
+			T bwdTan{ T() };
+			float tension{ 0.0f };
+			float bias{ 0.0f };
+			float continuity{ 0.0f };
+		};
+
+	public:
+		KeyTable() = default;
+		~KeyTable() { clear(); }
+
+		size_t size() const { return m_times.size(); }
+		bool empty() const { return m_times.empty(); }
+
+		template<KeyColumn C>
+		const std::vector<column_type<C>>& column() const
+		{
+			return const_cast<KeyTable<T>*>(this)->template col<C>();
+		}
+
+		const std::vector<float>& times() const { return m_times; }
+		const std::vector<T>& values() const { return m_values; }
+
+		template<KeyColumn C>
+		column_type<C> get(int i) const
+		{
+			assert(i >= 0 && (size_t)i < size());
+			return column<C>()[i];
+		}
+		template<KeyColumn C>
+		void set(int i, const column_type<C>& val)
+		{
+			assert(i >= 0 && (size_t)i < size());
+
+			auto&& c = col<C>();
+			if (c[i] != val) {
+				c[i] = val;
+				this->signal(Event<KeyTable<T>>{ Event<KeyTable<T>>::SET, i, -1, 1, C });
+			}
+		}
+		//Overwrites vals.size() values of column C, starting at pos. Signals once.
+		template<KeyColumn C>
+		void assign(int pos, const std::vector<column_type<C>>& vals)
+		{
+			assert(pos >= 0 && pos + vals.size() <= size());
+
+			if (!vals.empty()) {
+				std::copy(vals.begin(), vals.end(), col<C>().begin() + pos);
+				this->signal(Event<KeyTable<T>>{ Event<KeyTable<T>>::SET, pos, -1, static_cast<int>(vals.size()), C });
+			}
+		}
+
+		Row row(int i) const
+		{
+			assert(i >= 0 && (size_t)i < size());
+			return { m_times[i], m_values[i], m_fwdTans[i], m_bwdTans[i], m_tensions[i], m_biases[i], m_continuities[i] };
+		}
+
+		//Inserts count default keys before i
+		void insert(int i, int count = 1)
+		{
+			assert(i >= 0 && (size_t)i <= size() && count >= 0);
+
+			if (count > 0) {
+				forEachColumn([i, count](auto& c)
+					{
+						c.insert(c.begin() + i, count, typename std::decay_t<decltype(c)>::value_type());
+					});
+				this->signal(Event<KeyTable<T>>{ Event<KeyTable<T>>::INSERT, i, -1, count });
+			}
+		}
+		//Inserts a copy of row before i. Listeners see the insertion of a key that already has its values.
+		void insert(int i, const Row& row)
+		{
+			assert(i >= 0 && (size_t)i <= size());
+
+			m_times.insert(m_times.begin() + i, row.time);
+			m_values.insert(m_values.begin() + i, row.value);
+			m_fwdTans.insert(m_fwdTans.begin() + i, row.fwdTan);
+			m_bwdTans.insert(m_bwdTans.begin() + i, row.bwdTan);
+			m_tensions.insert(m_tensions.begin() + i, row.tension);
+			m_biases.insert(m_biases.begin() + i, row.bias);
+			m_continuities.insert(m_continuities.begin() + i, row.continuity);
+
+			this->signal(Event<KeyTable<T>>{ Event<KeyTable<T>>::INSERT, i });
+		}
+		//Erases count keys starting at i
+		void erase(int i, int count = 1)
+		{
+			assert(i >= 0 && count >= 0 && (size_t)(i + count) <= size());
+
+			if (count > 0) {
+				forEachColumn([i, count](auto& c) { c.erase(c.begin() + i, c.begin() + i + count); });
+				this->signal(Event<KeyTable<T>>{ Event<KeyTable<T>>::ERASE, i, -1, count });
+			}
+		}
+		void move(int from, int to)
+		{
+			assert(from >= 0 && (size_t)from < size());
+			assert(to >= 0 && (size_t)to < size());
+
+			if (from != to) {
+				forEachColumn([from, to](auto& c)
+					{
+						if (from < to)
+							std::rotate(c.begin() + from, c.begin() + from + 1, c.begin() + to + 1);
+						else
+							std::rotate(c.begin() + to, c.begin() + from, c.begin() + from + 1);
+					});
+				this->signal(Event<KeyTable<T>>{ Event<KeyTable<T>>::MOVE, from, to });
+			}
+		}
+
+		void push_back()
+		{
+			insert(static_cast<int>(size()));
+		}
+
+		void resize(int size)
+		{
+			assert(size >= 0);
+			int current = static_cast<int>(this->size());
+			if (current > size)
+				erase(size, current - size);
+			else
+				insert(current, size - current);
+		}
+
+		void clear()
+		{
+			erase(0, static_cast<int>(size()));
+		}
+
+	private:
+		template<KeyColumn C>
+		std::vector<column_type<C>>& col()
+		{
+			if constexpr (C == KeyColumn::TIME)
+				return m_times;
+			else if constexpr (C == KeyColumn::VALUE)
+				return m_values;
+			else if constexpr (C == KeyColumn::FWD_TAN)
+				return m_fwdTans;
+			else if constexpr (C == KeyColumn::BWD_TAN)
+				return m_bwdTans;
+			else if constexpr (C == KeyColumn::TENSION)
+				return m_tensions;
+			else if constexpr (C == KeyColumn::BIAS)
+				return m_biases;
+			else
+				return m_continuities;
+		}
+
+		template<typename Fcn>
+		void forEachColumn(Fcn&& f)
+		{
+			f(m_times);
+			f(m_values);
+			f(m_fwdTans);
+			f(m_bwdTans);
+			f(m_tensions);
+			f(m_biases);
+			f(m_continuities);
+		}
+
+	private:
+		std::vector<float> m_times;
+		std::vector<T> m_values;
+		std::vector<T> m_fwdTans;
+		std::vector<T> m_bwdTans;
+		std::vector<float> m_tensions;
+		std::vector<float> m_biases;
+		std::vector<float> m_continuities;
+	};
+}
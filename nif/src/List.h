@@ -18,12 +18,16 @@
 
 #pragma once
 #include <cassert>
-#include <list>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <vector>
 #include "Observable.h"
 
 namespace nif
 {
-	//An ordered list of items that are not copyable or movable
+	//An ordered list of items that are not copyable or movable.
+	//Elements keep their address for as long as they are in the list.
 
 	template<typename T> class List;
 
@@ -33,8 +37,11 @@ namespace nif
 		enum {
 			INSERT,
 			ERASE,
+			INSERT_RANGE,
+			ERASE_RANGE,
 		} type{ INSERT };
 		int pos{ -1 };
+		int count{ 1 };//number of elements, for ranges
 	};
 
 	template<typename T>
@@ -43,7 +50,7 @@ namespace nif
 	public:
 		virtual ~IListener() = default;
 
-		void receive(const Event<nif::List<T>>& e, Observable<nif::List<T>>&)
+		virtual void receive(const Event<nif::List<T>>& e, Observable<nif::List<T>>&)
 		{
 			switch (e.type) {
 			case Event<nif::List<T>>::INSERT:
@@ -52,19 +59,86 @@ namespace nif
 			case Event<nif::List<T>>::ERASE:
 				onErase(e.pos);
 				break;
+			case Event<nif::List<T>>::INSERT_RANGE:
+				onInsertRange(e.pos, e.count);
+				break;
+			case Event<nif::List<T>>::ERASE_RANGE:
+				onEraseRange(e.pos, e.count);
+				break;
 			}
 		}
 
 		//TODO: use iterators instead of ints
 		virtual void onInsert(int) {}
 		virtual void onErase(int) {}
+
+		//count elements were inserted/erased starting at pos. Override to handle them in one go.
+		virtual void onInsertRange(int pos, int count)
+		{
+			for (int i = 0; i < count; i++)
+				onInsert(pos + i);
+		}
+		virtual void onEraseRange(int pos, int count)
+		{
+			for (int i = count - 1; i >= 0; i--)
+				onErase(pos + i);
+		}
 	};
 	template<typename T> using ListListener = IListener<List<T>>;
 
 	template<typename T>
 	class List final : public Observable<List<T>>
 	{
-		using ctnr_type = std::list<T>;
+		//Elements live in their own allocation, so their addresses are stable while the index
+		//into them stays random access
+		using ctnr_type = std::vector<std::unique_ptr<T>>;
+
+		//Iterates over the elements rather than the pointers to them
+		template<typename V, typename It>
+		class iterator_base
+		{
+		public:
+			using iterator_category = std::random_access_iterator_tag;
+			using value_type = T;
+			using difference_type = std::ptrdiff_t;
+			using pointer = V*;
+			using reference = V&;
+
+			iterator_base() = default;
+			iterator_base(It it) : m_it{ it } {}
+			//iterator to const_iterator, not the other way
+			template<typename V2, typename It2,
+				typename = std::enable_if_t<std::is_same_v<const V2, V> && !std::is_same_v<V2, V> && std::is_convertible_v<It2, It>>>
+			iterator_base(const iterator_base<V2, It2>& other) : m_it{ other.m_it } {}
+
+			reference operator*() const { return **m_it; }
+			pointer operator->() const { return m_it->get(); }
+			reference operator[](difference_type n) const { return *m_it[n]; }
+
+			iterator_base& operator++() { ++m_it; return *this; }
+			iterator_base operator++(int) { return iterator_base(m_it++); }
+			iterator_base& operator--() { --m_it; return *this; }
+			iterator_base operator--(int) { return iterator_base(m_it--); }
+			iterator_base& operator+=(difference_type n) { m_it += n; return *this; }
+			iterator_base& operator-=(difference_type n) { m_it -= n; return *this; }
+
+			friend iterator_base operator+(iterator_base it, difference_type n) { return it += n; }
+			friend iterator_base operator+(difference_type n, iterator_base it) { return it += n; }
+			friend iterator_base operator-(iterator_base it, difference_type n) { return it -= n; }
+			friend difference_type operator-(const iterator_base& lhs, const iterator_base& rhs) { return lhs.m_it - rhs.m_it; }
+
+			friend bool operator==(const iterator_base& lhs, const iterator_base& rhs) { return lhs.m_it == rhs.m_it; }
+			friend bool operator!=(const iterator_base& lhs, const iterator_base& rhs) { return lhs.m_it != rhs.m_it; }
+			friend bool operator<(const iterator_base& lhs, const iterator_base& rhs) { return lhs.m_it < rhs.m_it; }
+			friend bool operator>(const iterator_base& lhs, const iterator_base& rhs) { return lhs.m_it > rhs.m_it; }
+			friend bool operator<=(const iterator_base& lhs, const iterator_base& rhs) { return lhs.m_it <= rhs.m_it; }
+			friend bool operator>=(const iterator_base& lhs, const iterator_base& rhs) { return lhs.m_it >= rhs.m_it; }
+
+		private:
+			template<typename V2, typename It2> friend class iterator_base;
+			It m_it;
+		};
+
 	public:
 		using element_type = T;
 
@@ -72,8 +146,8 @@ namespace nif
 		List() = default;
 		~List() { clear(); }
 
-		using iterator = typename ctnr_type::iterator;
-		using const_iterator = typename ctnr_type::const_iterator;
+		using iterator = iterator_base<T, typename ctnr_type::iterator>;
+		using const_iterator = iterator_base<const T, typename ctnr_type::const_iterator>;
 		iterator begin() { return m_ctnr.begin(); }
 		const_iterator begin() const { return m_ctnr.begin(); }
 		iterator end() { return m_ctnr.end(); }
@@ -82,18 +156,18 @@ namespace nif
 		T& at(int i) 
 		{ 
 			assert(i >= 0 && (size_t)i < size());
-			return *getIt(i);
+			return *m_ctnr[i];
 		}
 		const T& at(int i) const 
 		{
 			assert(i >= 0 && (size_t)i < size());
-			return *getIt(i);
+			return *m_ctnr[i];
 		}
 
-		T& back() { return m_ctnr.back(); }
-		const T& back() const { return m_ctnr.back(); }
-		T& front() { return m_ctnr.front(); }
-		const T& front() const { return m_ctnr.front(); }
+		T& back() { return *m_ctnr.back(); }
+		const T& back() const { return *m_ctnr.back(); }
+		T& front() { return *m_ctnr.front(); }
+		const T& front() const { return *m_ctnr.front(); }
 
 		//TODO: use iterators instead of ints
 		//We could template insertions to forward ctor arguments
@@ -101,32 +175,48 @@ namespace nif
 		{
 			assert(i >= 0 && (size_t)i <= m_ctnr.size());
 
-			if (i == 0)
-				m_ctnr.emplace_front();
-			else if (i == m_ctnr.size())
-				m_ctnr.emplace_back();
-			else
-				m_ctnr.emplace(getIt(i));
+			m_ctnr.insert(m_ctnr.begin() + i, std::make_unique<T>());
 
 			this->signal(Event<List<T>>{ Event<List<T>>::INSERT, i });
 
 			return i;
 		}
+		//Inserts count default elements before i
+		void insert(int i, int count)
+		{
+			assert(i >= 0 && (size_t)i <= m_ctnr.size() && count >= 0);
+
+			if (count > 0) {
+				ctnr_type elements;
+				elements.reserve(count);
+				for (int j = 0; j < count; j++)
+					elements.push_back(std::make_unique<T>());
+				m_ctnr.insert(m_ctnr.begin() + i, std::make_move_iterator(elements.begin()), std::make_move_iterator(elements.end()));
+
+				this->signal(Event<List<T>>{ Event<List<T>>::INSERT_RANGE, i, count });
+			}
+		}
 		int erase(int i)
 		{
 			assert(i >= 0 && (size_t)i < m_ctnr.size());
 
-			if (i == 0)
-				m_ctnr.pop_front();
-			else if (i == m_ctnr.size())
-				m_ctnr.pop_back();
-			else
-				m_ctnr.erase(getIt(i));
+			m_ctnr.erase(m_ctnr.begin() + i);
 
 			this->signal(Event<List<T>>{ Event<List<T>>::ERASE, i });
 
 			return i;
 		}
+		//Erases count elements starting at i
+		void erase(int i, int count)
+		{
+			assert(i >= 0 && count >= 0 && (size_t)(i + count) <= m_ctnr.size());
+
+			if (count > 0) {
+				m_ctnr.erase(m_ctnr.begin() + i, m_ctnr.begin() + i + count);
+
+				this->signal(Event<List<T>>{ Event<List<T>>::ERASE_RANGE, i, count });
+			}
+		}
 
 		void pop_back()
 		{
@@ -151,10 +241,11 @@ namespace nif
 		void resize(int size)
 		{
 			assert(size >= 0);
-			while (m_ctnr.size() > (size_t)size)
-				pop_back();
-			while (m_ctnr.size() < (size_t)size)
-				push_back();
+			int current = static_cast<int>(m_ctnr.size());
+			if (current > size)
+				erase(size, current - size);
+			else
+				insert(current, size - current);
 		}
 
 		size_t size() const
@@ -164,46 +255,10 @@ namespace nif
 
 		void clear()
 		{
-			while (!m_ctnr.empty())
-				pop_back();
+			erase(0, static_cast<int>(m_ctnr.size()));
 		}
 
 	private:
-		typename ctnr_type::iterator getIt(int i)
-		{
-			if (int ri = size() - i; i <= ri) {
-				//go front-to-back
-				auto it = m_ctnr.begin();
-				for (int j = 0; j < i; j++)
-					++it;
-				return it;
-			}
-			else {
-				//go back-to-front
-				auto rit = m_ctnr.rbegin();
-				for (int j = 0; j < ri; j++)
-					++rit;
-				return rit.base();
-			}
-		}
-		typename ctnr_type::const_iterator getIt(int i) const
-		{
-			if (int ri = size() - i; i <= ri) {
-				//go front-to-back
-				auto it = m_ctnr.begin();
-				for (int j = 0; j < i; j++)
-					++it;
-				return it;
-			}
-			else {
-				//go back-to-front
-				auto rit = m_ctnr.rbegin();
-				for (int j = 0; j < ri; j++)
-					++rit;
-				return rit.base();
-			}
-		}
-
 		ctnr_type m_ctnr;
 	};
 }
@@ -0,0 +1,76 @@
+//Copyright 2021 Jonas Gernandt
+//
+//This file is part of SVFX Editor, a program for creating visual effects
+//in the NetImmerse format.
+//
+//SVFX Editor is free software: you can redistribute it and/or modify
+//it under the terms of the GNU General Public License as published by
+//the Free Software Foundation, either version 3 of the License, or
+//(at your option) any later version.
+//
+//SVFX Editor is distributed in the hope that it will be useful,
+//but WITHOUT ANY WARRANTY; without even the implied warranty of
+//MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//GNU General Public License for more details.
+//
+//You should have received a copy of the GNU General Public License
+//along with SVFX Editor. If not, see <https://www.gnu.org/licenses/>.
+
+#include "pch.h"
+#include "Loader.h"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+std::vector<nif::LoadResult> nif::load_many(const std::vector<std::filesystem::path>& paths, unsigned int threads)
+{
+	std::vector<LoadResult> results(paths.size());
+
+	if (threads == 0)
+		threads = std::max(std::thread::hardware_concurrency(), 1u);
+	//Any threads we have left over after giving one to each file are shared out to read them with
+	unsigned int perFile = paths.empty() ? 1 : static_cast<unsigned int>(std::max<size_t>(threads / paths.size(), 1));
+	threads = static_cast<unsigned int>(std::min<size_t>(threads, paths.size()));
+
+	//Before any of the workers start reading
+	initNiflib();
+
+	//Files vary a lot in size, so we don't split the list up front. Every worker takes
+	//the next file in line when it is done with its last one, until none are left.
+	std::atomic<size_t> next{ 0 };
+
+	auto work = [&paths, &results, &next, perFile]()
+	{
+		for (size_t i = next++; i < paths.size(); i = next++) {
+			LoadResult& result = results[i];
+			result.path = paths[i];
+			try {
+				result.file = std::make_unique<File>(paths[i], perFile);
+			}
+			catch (const std::exception& e) {
+				result.error = e.what();
+			}
+			catch (...) {
+				result.error = "Unknown error";
+			}
+		}
+	};
+
+	if (threads > 1) {
+		std::vector<std::thread> workers;
+		workers.reserve(threads - 1);
+		for (unsigned int i = 1; i < threads; i++)
+			workers.emplace_back(work);
+
+		//We are a worker too
+		work();
+
+		for (auto&& worker : workers)
+			worker.join();
+	}
+	else
+		work();
+
+	return results;
+}
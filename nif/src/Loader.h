@@ -0,0 +1,52 @@
+//Copyright 2021 Jonas Gernandt
+//
+//This file is part of SVFX Editor, a program for creating visual effects
+//in the NetImmerse format.
+//
+//SVFX Editor is free software: you can redistribute it and/or modify
+//it under the terms of the GNU General Public License as published by
+//the Free Software Foundation, either version 3 of the License, or
+//(at your option) any later version.
+//
+//SVFX Editor is distributed in the hope that it will be useful,
+//but WITHOUT ANY WARRANTY; without even the implied warranty of
+//MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//GNU General Public License for more details.
+//
+//You should have received a copy of the GNU General Public License
+//along with SVFX Editor. If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "File.h"
+
+namespace nif
+{
+	//The outcome of loading one file
+	struct LoadResult
+	{
+		std::filesystem::path path;
+		//Null if the file failed to load
+		std::unique_ptr<File> file;
+		//Describes the failure, if there was one
+		std::string error;
+	};
+
+	//Load many files concurrently, on up to threads worker threads (0 to use one per hardware thread).
+	//If there are more threads than files, each file is read on several of them.
+	//Results are returned in the order of paths. A file that fails to load does not affect the others.
+	//
+	//Niflib is not written to be used from several threads. What makes this safe:
+	// - Each file's Niflib objects are only ever touched by the thread reading that file (a single
+	//   file read on several threads is split so that no two of them touch the same objects).
+	// - The object registry is filled once, by initNiflib, before any concurrent read. After that
+	//   it is only read from. The Niflib::Type objects are constants, set up at static initialisation.
+	// - NiObject's instance counter (NiObject::NumObjectsInMemory) is a plain static that every
+	//   Niflib object construction and destruction updates, unsynchronised. Its value is meaningless
+	//   while files are being read concurrently, and must not be relied on. Nothing else reads it.
+	[[nodiscard]] std::vector<LoadResult> load_many(const std::vector<std::filesystem::path>& paths, unsigned int threads = 0);
+}
@@ -0,0 +1,332 @@
+//Copyright 2021 Jonas Gernandt
+//
+//This file is part of SVFX Editor, a program for creating visual effects
+//in the NetImmerse format.
+//
+//SVFX Editor is free software: you can redistribute it and/or modify
+//it under the terms of the GNU General Public License as published by
+//the Free Software Foundation, either version 3 of the License, or
+//(at your option) any later version.
+//
+//SVFX Editor is distributed in the hope that it will be useful,
+//but WITHOUT ANY WARRANTY; without even the implied warranty of
+//MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//GNU General Public License for more details.
+//
+//You should have received a copy of the GNU General Public License
+//along with SVFX Editor. If not, see <https://www.gnu.org/licenses/>.
+
+#include "pch.h"
+#include "MappedFile.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+nif::MappedFile::MappedFile(const std::filesystem::path& path)
+{
+#ifdef _WIN32
+	HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL,
+		OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+	if (file == INVALID_HANDLE_VALUE)
+		throw std::runtime_error("Failed to open file");
+	m_file = file;
+
+	LARGE_INTEGER size;
+	if (!GetFileSizeEx(file, &size)) {
+		close();
+		throw std::runtime_error("Failed to read file size");
+	}
+	if (size.QuadPart == 0) {
+		//Empty files cannot be mapped
+		close();
+		throw std::runtime_error("File is empty");
+	}
+	m_size = static_cast<size_t>(size.QuadPart);
+
+	m_mapping = CreateFileMappingW(file, NULL, PAGE_READONLY, 0, 0, NULL);
+	if (!m_mapping) {
+		close();
+		throw std::runtime_error("Failed to map file");
+	}
+
+	m_data = static_cast<const char*>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+	if (!m_data) {
+		close();
+		throw std::runtime_error("Failed to map file");
+	}
+#else
+	int fd = open(path.c_str(), O_RDONLY);
+	if (fd == -1)
+		throw std::runtime_error("Failed to open file");
+
+	struct stat st {};
+	if (fstat(fd, &st) != 0 || st.st_size == 0) {
+		::close(fd);
+		throw std::runtime_error(st.st_size == 0 ? "File is empty" : "Failed to read file size");
+	}
+	m_size = static_cast<size_t>(st.st_size);
+
+	void* data = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	::close(fd);//the mapping stays valid
+	if (data == MAP_FAILED) {
+		m_size = 0;
+		throw std::runtime_error("Failed to map file");
+	}
+	m_data = static_cast<const char*>(data);
+#endif
+}
+
+nif::MappedFile::MappedFile(MappedFile&& other) noexcept
+{
+	*this = std::move(other);
+}
+
+nif::MappedFile::~MappedFile()
+{
+	close();
+}
+
+nif::MappedFile& nif::MappedFile::operator=(MappedFile&& other) noexcept
+{
+	if (this != &other) {
+		close();
+
+		std::swap(m_data, other.m_data);
+		std::swap(m_size, other.m_size);
+#ifdef _WIN32
+		std::swap(m_file, other.m_file);
+		std::swap(m_mapping, other.m_mapping);
+#endif
+	}
+	return *this;
+}
+
+void nif::MappedFile::close() noexcept
+{
+#ifdef _WIN32
+	if (m_data)
+		UnmapViewOfFile(m_data);
+	if (m_mapping)
+		CloseHandle(m_mapping);
+	if (m_file)
+		CloseHandle(m_file);
+	m_mapping = nullptr;
+	m_file = nullptr;
+#else
+	if (m_data)
+		munmap(const_cast<char*>(m_data), m_size);
+#endif
+	m_data = nullptr;
+	m_size = 0;
+}
+
+
+void nif::replaceFile(const std::filesystem::path& path, const char* data, size_t size)
+{
+	std::filesystem::path tmpPath = path;
+	tmpPath += ".tmp";
+
+#ifdef _WIN32
+	HANDLE file = CreateFileW(tmpPath.c_str(), GENERIC_WRITE, 0, NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (file == INVALID_HANDLE_VALUE)
+		throw std::runtime_error("Failed to open file");
+
+	bool ok = true;
+	for (size_t written = 0; ok && written < size;) {
+		DWORD chunk = static_cast<DWORD>(std::min(size - written, static_cast<size_t>(1) << 30));
+		DWORD result = 0;
+		ok = WriteFile(file, data + written, chunk, &result, NULL) && result == chunk;
+		written += result;
+	}
+	ok = ok && FlushFileBuffers(file);
+	CloseHandle(file);
+
+	if (!ok) {
+		DeleteFileW(tmpPath.c_str());
+		throw std::runtime_error("Failed to write file");
+	}
+	if (!MoveFileExW(tmpPath.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH)) {
+		DeleteFileW(tmpPath.c_str());
+		throw std::runtime_error("Failed to replace file");
+	}
+#else
+	int fd = open(tmpPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	if (fd == -1)
+		throw std::runtime_error("Failed to open file");
+
+	bool ok = true;
+	for (size_t written = 0; ok && written < size;) {
+		ssize_t result = ::write(fd, data + written, size - written);
+		if (result > 0)
+			written += static_cast<size_t>(result);
+		else
+			ok = result == -1 && errno == EINTR;
+	}
+	ok = ok && fsync(fd) == 0;
+	ok = ::close(fd) == 0 && ok;
+
+	if (!ok) {
+		unlink(tmpPath.c_str());
+		throw std::runtime_error("Failed to write file");
+	}
+	if (rename(tmpPath.c_str(), path.c_str()) != 0) {
+		unlink(tmpPath.c_str());
+		throw std::runtime_error("Failed to replace file");
+	}
+
+	//Make the rename itself durable
+	std::filesystem::path dir = path.has_parent_path() ? path.parent_path() : std::filesystem::path(".");
+	if (int dirfd = open(dir.c_str(), O_RDONLY); dirfd != -1) {
+		fsync(dirfd);
+		::close(dirfd);
+	}
+#endif
+}
+
+
+nif::MemoryStreamBuf::MemoryStreamBuf(const char* data, size_t size)
+{
+	//The get area is never written to, the const_cast is only to satisfy the interface
+	char* p = const_cast<char*>(data);
+	setg(p, p, p + size);
+}
+
+nif::MemoryStreamBuf::pos_type nif::MemoryStreamBuf::seekoff(
+	off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which)
+{
+	if (!(which & std::ios_base::in))
+		return pos_type(off_type(-1));
+
+	char* target;
+	switch (dir) {
+	case std::ios_base::beg:
+		target = eback() + off;
+		break;
+	case std::ios_base::cur:
+		target = gptr() + off;
+		break;
+	case std::ios_base::end:
+		target = egptr() + off;
+		break;
+	default:
+		return pos_type(off_type(-1));
+	}
+
+	if (target < eback() || target > egptr())
+		return pos_type(off_type(-1));
+
+	setg(eback(), target, egptr());
+	return pos_type(target - eback());
+}
+
+nif::MemoryStreamBuf::pos_type nif::MemoryStreamBuf::seekpos(pos_type pos, std::ios_base::openmode which)
+{
+	return seekoff(off_type(pos), std::ios_base::beg, which);
+}
+
+
+nif::BufferStreamBuf::BufferStreamBuf(size_t capacity)
+{
+	reserve(capacity);
+}
+
+size_t nif::BufferStreamBuf::size() const
+{
+	return std::max(m_size, static_cast<size_t>(pptr() - pbase()));
+}
+
+nif::BufferStreamBuf::int_type nif::BufferStreamBuf::overflow(int_type ch)
+{
+	if (traits_type::eq_int_type(ch, traits_type::eof()))
+		return traits_type::not_eof(ch);
+
+	reserve(static_cast<size_t>(pptr() - pbase()) + 1);
+	*pptr() = traits_type::to_char_type(ch);
+	pbump(1);
+	return ch;
+}
+
+std::streamsize nif::BufferStreamBuf::xsputn(const char* s, std::streamsize n)
+{
+	if (n <= 0)
+		return 0;
+
+	size_t pos = static_cast<size_t>(pptr() - pbase());
+	reserve(pos + static_cast<size_t>(n));
+	std::memcpy(pptr(), s, static_cast<size_t>(n));
+	setPos(pos + static_cast<size_t>(n));
+	return n;
+}
+
+nif::BufferStreamBuf::pos_type nif::BufferStreamBuf::seekoff(
+	off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which)
+{
+	if (!(which & std::ios_base::out))
+		return pos_type(off_type(-1));
+
+	off_type base;
+	switch (dir) {
+	case std::ios_base::beg:
+		base = 0;
+		break;
+	case std::ios_base::cur:
+		base = static_cast<off_type>(pptr() - pbase());
+		break;
+	case std::ios_base::end:
+		base = static_cast<off_type>(size());
+		break;
+	default:
+		return pos_type(off_type(-1));
+	}
+
+	off_type target = base + off;
+	if (target < 0 || static_cast<size_t>(target) > size())
+		return pos_type(off_type(-1));
+
+	m_size = size();
+	setPos(static_cast<size_t>(target));
+	return pos_type(target);
+}
+
+nif::BufferStreamBuf::pos_type nif::BufferStreamBuf::seekpos(pos_type pos, std::ios_base::openmode which)
+{
+	return seekoff(off_type(pos), std::ios_base::beg, which);
+}
+
+void nif::BufferStreamBuf::reserve(size_t capacity)
+{
+	if (capacity > m_buffer.size()) {
+		size_t pos = static_cast<size_t>(pptr() - pbase());
+		m_size = size();
+
+		m_buffer.resize(std::max({ capacity, 2 * m_buffer.size(), size_t(4096) }));
+		setp(m_buffer.data(), m_buffer.data() + m_buffer.size());
+		setPos(pos);
+	}
+}
+
+void nif::BufferStreamBuf::setPos(size_t pos)
+{
+	//pbump takes an int
+	setp(pbase(), epptr());
+	while (pos > 0) {
+		int step = static_cast<int>(std::min(pos, static_cast<size_t>(std::numeric_limits<int>::max())));
+		pbump(step);
+		pos -= static_cast<size_t>(step);
+	}
+}
@@ -0,0 +1,99 @@
+//Copyright 2021 Jonas Gernandt
+//
+//This file is part of SVFX Editor, a program for creating visual effects
+//in the NetImmerse format.
+//
+//SVFX Editor is free software: you can redistribute it and/or modify
+//it under the terms of the GNU General Public License as published by
+//the Free Software Foundation, either version 3 of the License, or
+//(at your option) any later version.
+//
+//SVFX Editor is distributed in the hope that it will be useful,
+//but WITHOUT ANY WARRANTY; without even the implied warranty of
+//MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//GNU General Public License for more details.
+//
+//You should have received a copy of the GNU General Public License
+//along with SVFX Editor. If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+#include <cstddef>
+#include <filesystem>
+#include <streambuf>
+#include <vector>
+
+namespace nif
+{
+	//Read-only view of a whole file, mapped into memory.
+	//Throws std::runtime_error if the file cannot be opened or mapped.
+	class MappedFile
+	{
+	public:
+		MappedFile(const std::filesystem::path& path);
+		MappedFile(const MappedFile&) = delete;
+		MappedFile(MappedFile&& other) noexcept;
+
+		~MappedFile();
+
+		MappedFile& operator=(const MappedFile&) = delete;
+		MappedFile& operator=(MappedFile&& other) noexcept;
+
+		const char* data() const { return m_data; }
+		size_t size() const { return m_size; }
+
+	private:
+		void close() noexcept;
+
+	private:
+		const char* m_data{ nullptr };
+		size_t m_size{ 0 };
+
+#ifdef _WIN32
+		void* m_file{ nullptr };
+		void* m_mapping{ nullptr };
+#endif
+	};
+
+	//Write size bytes to a temporary file next to path, flush it to disk and rename it to path.
+	//Path will hold either its previous content or all of the new, even if we are interrupted.
+	//Throws std::runtime_error on failure.
+	void replaceFile(const std::filesystem::path& path, const char* data, size_t size);
+
+	//Exposes a range of memory as an input stream buffer, without copying it.
+	//For feeding mapped files to stream based readers.
+	class MemoryStreamBuf final : public std::streambuf
+	{
+	public:
+		MemoryStreamBuf(const char* data, size_t size);
+
+	protected:
+		virtual pos_type seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which) override;
+		virtual pos_type seekpos(pos_type pos, std::ios_base::openmode which) override;
+	};
+
+	//Output stream buffer that collects everything written to it in one growing block of memory.
+	//For serialising with stream based writers, without a system call per field.
+	class BufferStreamBuf final : public std::streambuf
+	{
+	public:
+		BufferStreamBuf(size_t capacity = 0);
+
+		const char* data() const { return pbase(); }
+		//Includes anything written before a seek back
+		size_t size() const;
+
+	protected:
+		virtual int_type overflow(int_type ch) override;
+		virtual std::streamsize xsputn(const char* s, std::streamsize n) override;
+		virtual pos_type seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which) override;
+		virtual pos_type seekpos(pos_type pos, std::ios_base::openmode which) override;
+
+	private:
+		void reserve(size_t capacity);
+		void setPos(size_t pos);
+
+	private:
+		std::vector<char> m_buffer;
+		size_t m_size{ 0 };
+	};
+}
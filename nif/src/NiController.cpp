@@ -35,23 +35,57 @@ const size_t nif::NiPSysModifierCtlr::TYPE = std::hash<std::string>{}("NiPSysMod
 const size_t nif::NiPSysEmitterCtlr::TYPE = std::hash<std::string>{}("NiPSysEmitterCtlr");
 const size_t nif::NiPSysGravityStrengthCtlr::TYPE = std::hash<std::string>{}("NiPSysGravityStrengthCtlr");
 
+//Fill each column in one go, so listeners get one event per column rather than per key
+template<typename T, typename NativeT>
+static void readKeys(nif::KeyTable<T>& keys, const std::vector<Niflib::Key<NativeT>>& native)
+{
+	using nif::KeyColumn;
+
+	std::vector<float> times(native.size());
+	std::vector<T> values(native.size());
+	std::vector<T> fwdTans(native.size());
+	std::vector<T> bwdTans(native.size());
+	std::vector<float> tensions(native.size());
+	std::vector<float> biases(native.size());
+	std::vector<float> continuities(native.size());
+	for (size_t i = 0; i < native.size(); i++) {
+		times[i] = native[i].time;
+		values[i] = static_cast<T>(native[i].data);
+		fwdTans[i] = static_cast<T>(native[i].forward_tangent);
+		bwdTans[i] = static_cast<T>(native[i].backward_tangent);
+		tensions[i] = native[i].tension;
+		biases[i] = native[i].bias;
+		continuities[i] = native[i].continuity;
+	}
+
+	keys.resize(static_cast<int>(native.size()));
+	keys.template assign<KeyColumn::TIME>(0, times);
+	keys.template assign<KeyColumn::VALUE>(0, values);
+	keys.template assign<KeyColumn::FWD_TAN>(0, fwdTans);
+	keys.template assign<KeyColumn::BWD_TAN>(0, bwdTans);
+	keys.template assign<KeyColumn::TENSION>(0, tensions);
+	keys.template assign<KeyColumn::BIAS>(0, biases);
+	keys.template assign<KeyColumn::CONTINUITY>(0, continuities);
+}
+
+template<typename T, typename NativeT>
+static void writeKeys(const nif::KeyTable<T>& keys, std::vector<Niflib::Key<NativeT>>& native)
+{
+	native.resize(keys.size());
+	for (size_t i = 0; i < keys.size(); i++) {
+		auto row = keys.row(static_cast<int>(i));
+		native[i] = { row.time, static_cast<NativeT>(row.value), static_cast<NativeT>(row.fwdTan),
+			static_cast<NativeT>(row.bwdTan), row.tension, row.bias, row.continuity };
+	}
+}
+
 bool nif::ReadSyncer<nif::NiBoolData>::operator()(NiBoolData& object, const Niflib::NiBoolData* native, File& file)
 {
 	assert(native);
 
 	object.keyType.set(nif_type_conversion<KeyType>::from(native->GetKeyType()));
 
-	object.keys.clear();
-	for (auto&& key : native->GetKeys()) {
-		object.keys.push_back();
-		object.keys.back().time.set(key.time);
-		object.keys.back().value.set(static_cast<bool>(key.data));
-		object.keys.back().fwdTan.set(static_cast<bool>(key.forward_tangent));
-		object.keys.back().bwdTan.set(static_cast<bool>(key.backward_tangent));
-		object.keys.back().tension.set(key.tension);
-		object.keys.back().bias.set(key.bias);
-		object.keys.back().continuity.set(key.continuity);
-	}
+	readKeys(object.keys, native->GetKeys());
 	return true;
 }
 
@@ -61,12 +95,14 @@ bool nif::WriteSyncer<nif::NiBoolData>::operator()(const NiBoolData& object, Nif
 
 	native->SetKeyType(nif_type_conversion<Niflib::KeyType>::from(object.keyType.get()));
 
-	auto&& keys = native->GetKeysRef();
-	keys.clear();
-	for (auto&& key : object.keys) {
-		keys.push_back({ key.time.get(), key.value.get(), key.fwdTan.get(),
-			key.bwdTan.get(), key.tension.get(), key.bias.get(), key.continuity.get() });
-	}
+	writeKeys(object.keys, native->GetKeysRef());
+	return true;
+}
+
+bool nif::ChangeSubscriber<nif::NiBoolData>::operator()(NiBoolData& object, ChangeTracker& tracker)
+{
+	tracker.subscribe(object.keyType);
+	tracker.subscribe(object.keys);
 	return true;
 }
 
@@ -77,17 +113,7 @@ bool nif::ReadSyncer<nif::NiFloatData>::operator()(NiFloatData& object, const Ni
 
 	object.keyType.set(nif_type_conversion<KeyType>::from(native->GetKeyType()));
 
-	object.keys.clear();
-	for (auto&& key : native->GetKeys()) {
-		object.keys.push_back();
-		object.keys.back().time.set(key.time);
-		object.keys.back().value.set(key.data);
-		object.keys.back().fwdTan.set(key.forward_tangent);
-		object.keys.back().bwdTan.set(key.backward_tangent);
-		object.keys.back().tension.set(key.tension);
-		object.keys.back().bias.set(key.bias);
-		object.keys.back().continuity.set(key.continuity);
-	}
+	readKeys(object.keys, native->GetKeys());
 	return true;
 }
 
@@ -97,12 +123,14 @@ bool nif::WriteSyncer<nif::NiFloatData>::operator()(const NiFloatData& object, N
 
 	native->SetKeyType(nif_type_conversion<Niflib::KeyType>::from(object.keyType.get()));
 
-	auto&& keys = native->GetKeysRef();
-	keys.clear();
-	for (auto&& key : object.keys) {
-		keys.push_back({ key.time.get(), key.value.get(), key.fwdTan.get(),
-			key.bwdTan.get(), key.tension.get(), key.bias.get(), key.continuity.get() });
-	}
+	writeKeys(object.keys, native->GetKeysRef());
+	return true;
+}
+
+bool nif::ChangeSubscriber<nif::NiFloatData>::operator()(NiFloatData& object, ChangeTracker& tracker)
+{
+	tracker.subscribe(object.keyType);
+	tracker.subscribe(object.keys);
 	return true;
 }
 
@@ -110,7 +138,7 @@ bool nif::WriteSyncer<nif::NiFloatData>::operator()(const NiFloatData& object, N
 bool nif::Forwarder<nif::NiBoolInterpolator>::operator()(NiBoolInterpolator& object, NiTraverser& traverser)
 {
 	if (auto&& data = object.data.assigned())
-		data->receive(traverser);
+		data->dispatch(traverser);
 	return true;
 }
 
@@ -130,11 +158,18 @@ bool nif::WriteSyncer<nif::NiBoolInterpolator>::operator()(const NiBoolInterpola
 	return true;
 }
 
+bool nif::ChangeSubscriber<nif::NiBoolInterpolator>::operator()(NiBoolInterpolator& object, ChangeTracker& tracker)
+{
+	tracker.subscribe(object.value);
+	tracker.subscribe(object.data);
+	return true;
+}
+
 
 bool nif::Forwarder<nif::NiFloatInterpolator>::operator()(NiFloatInterpolator& object, NiTraverser& traverser)
 {
 	if (auto&& data = object.data.assigned())
-		data->receive(traverser);
+		data->dispatch(traverser);
 	return true;
 }
 
@@ -154,6 +189,13 @@ bool nif::WriteSyncer<nif::NiFloatInterpolator>::operator()(const NiFloatInterpo
 	return true;
 }
 
+bool nif::ChangeSubscriber<nif::NiFloatInterpolator>::operator()(NiFloatInterpolator& object, ChangeTracker& tracker)
+{
+	tracker.subscribe(object.value);
+	tracker.subscribe(object.data);
+	return true;
+}
+
 
 bool nif::ReadSyncer<nif::NiTimeController>::operator()(NiTimeController& object, const Niflib::NiTimeController* native, File& file)
 {
@@ -183,11 +225,22 @@ bool nif::WriteSyncer<nif::NiTimeController>::operator()(const NiTimeController&
 	return true;
 }
 
+bool nif::ChangeSubscriber<nif::NiTimeController>::operator()(NiTimeController& object, ChangeTracker& tracker)
+{
+	tracker.subscribe(object.flags);
+	tracker.subscribe(object.frequency);
+	tracker.subscribe(object.phase);
+	tracker.subscribe(object.startTime);
+	tracker.subscribe(object.stopTime);
+	tracker.subscribe(object.target);
+	return true;
+}
+
 
 bool nif::Forwarder<nif::NiSingleInterpController>::operator()(NiSingleInterpController& object, NiTraverser& traverser)
 {
 	if (auto&& iplr = object.interpolator.assigned())
-		iplr->receive(traverser);
+		iplr->dispatch(traverser);
 	return true;
 }
 
@@ -205,18 +258,9 @@ bool nif::WriteSyncer<nif::NiSingleInterpController>::operator()(const NiSingleI
 	return true;
 }
 
-
-bool nif::ReadSyncer<nif::NiPSysModifierCtlr>::operator()(NiPSysModifierCtlr& object, const Niflib::NiPSysModifierCtlr* native, File& file)
+bool nif::ChangeSubscriber<nif::NiSingleInterpController>::operator()(NiSingleInterpController& object, ChangeTracker& tracker)
 {
-	assert(native);
-	object.modifierName.set(native->GetModifierName());
-	return true;
-}
-
-bool nif::WriteSyncer<nif::NiPSysModifierCtlr>::operator()(const NiPSysModifierCtlr& object, Niflib::NiPSysModifierCtlr* native, const File& file)
-{
-	assert(native);
-	native->SetModifierName(object.modifierName.get());
+	tracker.subscribe(object.interpolator);
 	return true;
 }
 
@@ -224,20 +268,6 @@ bool nif::WriteSyncer<nif::NiPSysModifierCtlr>::operator()(const NiPSysModifierC
 bool nif::Forwarder<nif::NiPSysEmitterCtlr>::operator()(NiPSysEmitterCtlr& object, NiTraverser& traverser)
 {
 	if (auto&& obj = object.visIplr.assigned())
-		obj->receive(traverser);
-	return true;
-}
-
-bool nif::ReadSyncer<nif::NiPSysEmitterCtlr>::operator()(NiPSysEmitterCtlr& object, const Niflib::NiPSysEmitterCtlr* native, File& file)
-{
-	assert(native);
-	object.visIplr.assign(file.get<NiInterpolator>(native->GetVisibilityInterpolator()));
-	return true;
-}
-
-bool nif::WriteSyncer<nif::NiPSysEmitterCtlr>::operator()(const NiPSysEmitterCtlr& object, Niflib::NiPSysEmitterCtlr* native, const File& file)
-{
-	assert(native);
-	native->SetVisibilityInterpolator(file.getNative<NiInterpolator>(object.visIplr.assigned().get()));
+		obj->dispatch(traverser);
 	return true;
 }
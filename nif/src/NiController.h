@@ -53,7 +53,7 @@ namespace nif
 	struct NiBoolData : NiTraversable<NiBoolData, NiObject>
 	{
 		Property<KeyType> keyType;
-		Vector<Key<bool>> keys;
+		KeyTable<bool> keys;
 
 		static const ni_type TYPE;
 		virtual ni_type type() const override { return TYPE; }
@@ -62,7 +62,7 @@ namespace nif
 	struct NiFloatData : NiTraversable<NiFloatData, NiObject>
 	{
 		Property<KeyType> keyType;
-		Vector<Key<float>> keys;
+		KeyTable<float> keys;
 
 		static const ni_type TYPE;
 		virtual ni_type type() const override { return TYPE; }
@@ -33,6 +33,10 @@ namespace nif
 	{
 		bool operator() (const NiBoolData& object, Niflib::NiBoolData* native, const File& file);
 	};
+	template<> struct ChangeSubscriber<NiBoolData> : VerticalTraverser<NiBoolData, ChangeSubscriber>
+	{
+		bool operator() (NiBoolData& object, ChangeTracker& tracker);
+	};
 
 	//NiFloatData
 	template<> struct type_map<Niflib::NiFloatData> { using type = NiFloatData; };
@@ -45,6 +49,10 @@ namespace nif
 	{
 		bool operator() (const NiFloatData& object, Niflib::NiFloatData* native, const File& file);
 	};
+	template<> struct ChangeSubscriber<NiFloatData> : VerticalTraverser<NiFloatData, ChangeSubscriber>
+	{
+		bool operator() (NiFloatData& object, ChangeTracker& tracker);
+	};
 
 	//NiInterpolator
 	template<> struct type_map<Niflib::NiInterpolator> { using type = NiInterpolator; };
@@ -62,6 +70,10 @@ namespace nif
 	{
 		bool operator() (const NiBoolInterpolator& object, Niflib::NiBoolInterpolator* native, const File& file);
 	};
+	template<> struct ChangeSubscriber<NiBoolInterpolator> : VerticalTraverser<NiBoolInterpolator, ChangeSubscriber>
+	{
+		bool operator() (NiBoolInterpolator& object, ChangeTracker& tracker);
+	};
 
 	//NiFloatInterpolator
 	template<> struct type_map<Niflib::NiFloatInterpolator> { using type = NiFloatInterpolator; };
@@ -75,6 +87,10 @@ namespace nif
 	{
 		bool operator() (const NiFloatInterpolator& object, Niflib::NiFloatInterpolator* native, const File& file);
 	};
+	template<> struct ChangeSubscriber<NiFloatInterpolator> : VerticalTraverser<NiFloatInterpolator, ChangeSubscriber>
+	{
+		bool operator() (NiFloatInterpolator& object, ChangeTracker& tracker);
+	};
 
 	//NiBlendInterpolator
 	template<> struct type_map<Niflib::NiBlendInterpolator> { using type = NiBlendInterpolator; };
@@ -100,6 +116,10 @@ namespace nif
 	{
 		bool operator() (const NiTimeController& object, Niflib::NiTimeController* native, const File& file);
 	};
+	template<> struct ChangeSubscriber<NiTimeController> : VerticalTraverser<NiTimeController, ChangeSubscriber>
+	{
+		bool operator() (NiTimeController& object, ChangeTracker& tracker);
+	};
 
 	//NiSingleInterpController
 	template<> struct type_map<Niflib::NiSingleInterpController> { using type = NiSingleInterpController; };
@@ -113,6 +133,10 @@ namespace nif
 	{
 		bool operator() (const NiSingleInterpController& object, Niflib::NiSingleInterpController* native, const File& file);
 	};
+	template<> struct ChangeSubscriber<NiSingleInterpController> : VerticalTraverser<NiSingleInterpController, ChangeSubscriber>
+	{
+		bool operator() (NiSingleInterpController& object, ChangeTracker& tracker);
+	};
 
 	//NiPSysUpdateCtlr
 	template<> struct type_map<Niflib::NiPSysUpdateCtlr> { using type = NiPSysUpdateCtlr; };
@@ -122,26 +146,20 @@ namespace nif
 	template<> struct type_map<Niflib::NiPSysModifierCtlr> { using type = NiPSysModifierCtlr; };
 	template<> struct type_map<NiPSysModifierCtlr> { using type = Niflib::NiPSysModifierCtlr; };
 
-	template<> struct ReadSyncer<NiPSysModifierCtlr> : VerticalTraverser<NiPSysModifierCtlr, ReadSyncer>
+	template<> struct field_table<NiPSysModifierCtlr>
 	{
-		bool operator() (NiPSysModifierCtlr& object, const Niflib::NiPSysModifierCtlr* native, File& file);
-	};
-	template<> struct WriteSyncer<NiPSysModifierCtlr> : VerticalTraverser<NiPSysModifierCtlr, WriteSyncer>
-	{
-		bool operator() (const NiPSysModifierCtlr& object, Niflib::NiPSysModifierCtlr* native, const File& file);
+		constexpr static auto fields = std::make_tuple(
+			field(&NiPSysModifierCtlr::modifierName, &Niflib::NiPSysModifierCtlr::GetModifierName, &Niflib::NiPSysModifierCtlr::SetModifierName));
 	};
 
 	//NiPSysEmitterCtlr
 	template<> struct type_map<Niflib::NiPSysEmitterCtlr> { using type = NiPSysEmitterCtlr; };
 	template<> struct type_map<NiPSysEmitterCtlr> { using type = Niflib::NiPSysEmitterCtlr; };
 
-	template<> struct ReadSyncer<NiPSysEmitterCtlr> : VerticalTraverser<NiPSysEmitterCtlr, ReadSyncer>
-	{
-		bool operator() (NiPSysEmitterCtlr& object, const Niflib::NiPSysEmitterCtlr* native, File& file);
-	};
-	template<> struct WriteSyncer<NiPSysEmitterCtlr> : VerticalTraverser<NiPSysEmitterCtlr, WriteSyncer>
+	template<> struct field_table<NiPSysEmitterCtlr>
 	{
-		bool operator() (const NiPSysEmitterCtlr& object, Niflib::NiPSysEmitterCtlr* native, const File& file);
+		constexpr static auto fields = std::make_tuple(
+			field(&NiPSysEmitterCtlr::visIplr, &Niflib::NiPSysEmitterCtlr::GetVisibilityInterpolator, &Niflib::NiPSysEmitterCtlr::SetVisibilityInterpolator));
 	};
 
 	//NiPSysGravityStrengthCtlr
@@ -23,36 +23,6 @@ const size_t nif::NiExtraData::TYPE = std::hash<std::string>{}("NiExtraData");
 const size_t nif::NiStringExtraData::TYPE = std::hash<std::string>{}("NiStringExtraData");
 const size_t nif::NiStringsExtraData::TYPE = std::hash<std::string>{}("NiStringsExtraData");
 
-bool nif::ReadSyncer<nif::NiExtraData>::operator()(NiExtraData& object, const Niflib::NiExtraData* native, File& file)
-{
-	assert(native);
-	object.name.set(native->GetName());
-	return true;
-}
-
-bool nif::WriteSyncer<nif::NiExtraData>::operator()(const NiExtraData& object, Niflib::NiExtraData* native, const File& file)
-{
-	assert(native);
-	native->SetName(object.name.get());
-	return true;
-}
-
-
-bool nif::ReadSyncer<nif::NiStringExtraData>::operator()(NiStringExtraData& object, const Niflib::NiStringExtraData* native, File& file)
-{
-	assert(native);
-	object.value.set(native->GetData());
-	return true;
-}
-
-bool nif::WriteSyncer<nif::NiStringExtraData>::operator()(const NiStringExtraData& object, Niflib::NiStringExtraData* native, const File& file)
-{
-	assert(native);
-	native->SetData(object.value.get());
-	return true;
-}
-
-
 bool nif::ReadSyncer<nif::NiStringsExtraData>::operator()(NiStringsExtraData& object, const Niflib::NiStringsExtraData* native, File& file)
 {
 	assert(native);
@@ -69,7 +39,13 @@ bool nif::WriteSyncer<nif::NiStringsExtraData>::operator()(const NiStringsExtraD
 	assert(native);
 	std::vector<std::string> strings(object.strings.size());
 	for (size_t i = 0; i < strings.size(); i++)
-		strings[i] = object.strings.at(i).get();
+		strings[i] = object.strings.at(i).view();
 	native->SetData(std::move(strings));
 	return true;
 }
+
+bool nif::ChangeSubscriber<nif::NiStringsExtraData>::operator()(NiStringsExtraData& object, ChangeTracker& tracker)
+{
+	tracker.subscribe(object.strings);
+	return true;
+}
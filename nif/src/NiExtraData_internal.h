@@ -25,25 +25,19 @@ namespace nif
 	//NiExtraData
 	template<> struct type_map<Niflib::NiExtraData> { using type = NiExtraData; };
 	template<> struct type_map<NiExtraData> { using type = Niflib::NiExtraData; };
-	template<> struct ReadSyncer<NiExtraData> : VerticalTraverser<NiExtraData, ReadSyncer>
+	template<> struct field_table<NiExtraData>
 	{
-		bool operator() (NiExtraData& object, const Niflib::NiExtraData* native, File& file);
-	};
-	template<> struct WriteSyncer<NiExtraData> : VerticalTraverser<NiExtraData, WriteSyncer>
-	{
-		bool operator() (const NiExtraData& object, Niflib::NiExtraData* native, const File& file);
+		constexpr static auto fields = std::make_tuple(
+			field(&NiExtraData::name, &Niflib::NiExtraData::GetName, &Niflib::NiExtraData::SetName));
 	};
 
 	//NiStringExtraData
 	template<> struct type_map<Niflib::NiStringExtraData> { using type = NiStringExtraData; };
 	template<> struct type_map<NiStringExtraData> { using type = Niflib::NiStringExtraData; };
-	template<> struct ReadSyncer<NiStringExtraData> : VerticalTraverser<NiStringExtraData, ReadSyncer>
-	{
-		bool operator() (NiStringExtraData& object, const Niflib::NiStringExtraData* native, File& file);
-	};
-	template<> struct WriteSyncer<NiStringExtraData> : VerticalTraverser<NiStringExtraData, WriteSyncer>
+	template<> struct field_table<NiStringExtraData>
 	{
-		bool operator() (const NiStringExtraData& object, Niflib::NiStringExtraData* native, const File& file);
+		constexpr static auto fields = std::make_tuple(
+			field(&NiStringExtraData::value, &Niflib::NiStringExtraData::GetData, &Niflib::NiStringExtraData::SetData));
 	};
 
 	//NiStringsExtraData
@@ -57,4 +51,8 @@ namespace nif
 	{
 		bool operator() (const NiStringsExtraData& object, Niflib::NiStringsExtraData* native, const File& file);
 	};
+	template<> struct ChangeSubscriber<NiStringsExtraData> : VerticalTraverser<NiStringsExtraData, ChangeSubscriber>
+	{
+		bool operator() (NiStringsExtraData& object, ChangeTracker& tracker);
+	};
 }
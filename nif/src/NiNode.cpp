@@ -28,7 +28,7 @@ bool nif::Forwarder<nif::NiNode>::operator()(NiNode& object, NiTraverser& traver
 {
 	for (auto&& child : object.children) {
 		assert(child);
-		child->receive(traverser);
+		child->dispatch(traverser);
 	}
 	return true;
 }
@@ -64,6 +64,12 @@ bool nif::WriteSyncer<nif::NiNode>::operator()(const NiNode& object, Niflib::NiN
 	return true;
 }
 
+bool nif::ChangeSubscriber<nif::NiNode>::operator()(NiNode& object, ChangeTracker& tracker)
+{
+	tracker.subscribe(object.children);
+	return true;
+}
+
 
 bool nif::ReadSyncer<nif::NiBillboardNode>::operator()(
 	NiBillboardNode& object, const Niflib::NiBillboardNode* native, File& file)
@@ -80,3 +86,9 @@ bool nif::WriteSyncer<nif::NiBillboardNode>::operator()(
 	native->SetBillboardMode(nif_type_conversion<Niflib::BillboardMode>::from(object.mode.get()));
 	return true;
 }
+
+bool nif::ChangeSubscriber<nif::NiBillboardNode>::operator()(NiBillboardNode& object, ChangeTracker& tracker)
+{
+	tracker.subscribe(object.mode);
+	return true;
+}
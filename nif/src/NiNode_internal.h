@@ -34,6 +34,10 @@ namespace nif
 	{
 		bool operator() (const NiNode& object, Niflib::NiNode* native, const File& file);
 	};
+	template<> struct ChangeSubscriber<NiNode> : VerticalTraverser<NiNode, ChangeSubscriber>
+	{
+		bool operator() (NiNode& object, ChangeTracker& tracker);
+	};
 
 
 	//NiBillboardNode
@@ -48,6 +52,10 @@ namespace nif
 	{
 		bool operator() (const NiBillboardNode& object, Niflib::NiBillboardNode* native, const File& file);
 	};
+	template<> struct ChangeSubscriber<NiBillboardNode> : VerticalTraverser<NiBillboardNode, ChangeSubscriber>
+	{
+		bool operator() (NiBillboardNode& object, ChangeTracker& tracker);
+	};
 
 
 	//BSFadeNode
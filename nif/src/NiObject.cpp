@@ -46,12 +46,12 @@ bool nif::Forwarder<nif::NiObjectNET>::operator()(NiObjectNET& object, NiTravers
 {
 	for (auto&& data : object.extraData) {
 		assert(data);
-		data->receive(traverser);
+		data->dispatch(traverser);
 	}
 
 	for (auto&& controller : object.controllers) {
 		assert(controller);
-		controller->receive(traverser);
+		controller->dispatch(traverser);
 	}
 
 	return true;
@@ -80,7 +80,7 @@ bool nif::WriteSyncer<nif::NiObjectNET>::operator()(const NiObjectNET& object, N
 {
 	assert(native);
 
-	native->SetName(object.name.get());
+	native->SetName(object.name.view());
 
 	native->ClearExtraData();
 	for (auto&& data : object.extraData)
@@ -94,6 +94,14 @@ bool nif::WriteSyncer<nif::NiObjectNET>::operator()(const NiObjectNET& object, N
 	return true;
 }
 
+bool nif::ChangeSubscriber<nif::NiObjectNET>::operator()(NiObjectNET& object, ChangeTracker& tracker)
+{
+	tracker.subscribe(object.name);
+	tracker.subscribe(object.extraData);
+	tracker.subscribe(object.controllers);
+	return true;
+}
+
 bool nif::ReadSyncer<nif::NiAVObject>::operator()(NiAVObject& object, const Niflib::NiAVObject* native, File& file)
 {
 	assert(native);
@@ -119,3 +127,12 @@ bool nif::WriteSyncer<nif::NiAVObject>::operator()(const NiAVObject& object, Nif
 	return true;
 }
 
+bool nif::ChangeSubscriber<nif::NiAVObject>::operator()(NiAVObject& object, ChangeTracker& tracker)
+{
+	tracker.subscribe(object.flags);
+	tracker.subscribe(object.transform.translation);
+	tracker.subscribe(object.transform.rotation);
+	tracker.subscribe(object.transform.scale);
+	return true;
+}
+
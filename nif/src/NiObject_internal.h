@@ -18,21 +18,24 @@
 
 #pragma once
 #include "NiObject.h"
+#include "ChangeTracker.h"
+#include "FieldTable.h"
 
 namespace nif
 {
 	class File;
 
-	//Transfers state between our model and Niflib (specialise and implement).
+	//Transfers state between our model and Niflib.
+	//By default, syncs the fields in the field_table of T. Specialise and implement for anything else.
 	template<typename T>
 	struct ReadSyncer : VerticalTraverser<T, ReadSyncer>
 	{
-		bool operator() (T& object, const typename type_map<T>::type* native, File& file) { return true; }
+		bool operator() (T& object, const typename type_map<T>::type* native, File& file) { return readFields(object, native, file); }
 	};
 	template<typename T>
 	struct WriteSyncer : VerticalTraverser<T, WriteSyncer>
 	{
-		bool operator() (const T& object, typename type_map<T>::type* native, const File& file) { return true; }
+		bool operator() (const T& object, typename type_map<T>::type* native, const File& file) { return writeFields(object, native, file); }
 	};
 
 	//NiObject
@@ -51,6 +54,10 @@ namespace nif
 	{
 		bool operator() (const NiObjectNET& object, Niflib::NiObjectNET* native, const File& file);
 	};
+	template<> struct ChangeSubscriber<NiObjectNET> : VerticalTraverser<NiObjectNET, ChangeSubscriber>
+	{
+		bool operator() (NiObjectNET& object, ChangeTracker& tracker);
+	};
 
 	//NiAVObject
 	template<> struct type_map<Niflib::NiAVObject> { using type = NiAVObject; };
@@ -64,4 +71,8 @@ namespace nif
 	{
 		bool operator() (const NiAVObject& object, Niflib::NiAVObject* native, const File& file);
 	};
+	template<> struct ChangeSubscriber<NiAVObject> : VerticalTraverser<NiAVObject, ChangeSubscriber>
+	{
+		bool operator() (NiAVObject& object, ChangeTracker& tracker);
+	};
 }
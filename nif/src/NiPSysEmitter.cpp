@@ -63,6 +63,22 @@ bool nif::WriteSyncer<nif::NiPSysEmitter>::operator()(const NiPSysEmitter& objec
 	return true;
 }
 
+bool nif::ChangeSubscriber<nif::NiPSysEmitter>::operator()(NiPSysEmitter& object, ChangeTracker& tracker)
+{
+	tracker.subscribe(object.colour);
+	tracker.subscribe(object.lifeSpan);
+	tracker.subscribe(object.lifeSpanVar);
+	tracker.subscribe(object.size);
+	tracker.subscribe(object.sizeVar);
+	tracker.subscribe(object.speed);
+	tracker.subscribe(object.speedVar);
+	tracker.subscribe(object.azimuth);
+	tracker.subscribe(object.azimuthVar);
+	tracker.subscribe(object.elevation);
+	tracker.subscribe(object.elevationVar);
+	return true;
+}
+
 
 bool nif::ReadSyncer<nif::NiPSysVolumeEmitter>::operator()(NiPSysVolumeEmitter& object, const Niflib::NiPSysVolumeEmitter* native, File& file)
 {
@@ -80,6 +96,12 @@ bool nif::WriteSyncer<nif::NiPSysVolumeEmitter>::operator()(const NiPSysVolumeEm
 	return true;
 }
 
+bool nif::ChangeSubscriber<nif::NiPSysVolumeEmitter>::operator()(NiPSysVolumeEmitter& object, ChangeTracker& tracker)
+{
+	tracker.subscribe(object.emitterObject);
+	return true;
+}
+
 
 bool nif::ReadSyncer<nif::NiPSysBoxEmitter>::operator()(NiPSysBoxEmitter& object, const Niflib::NiPSysBoxEmitter* native, File& file)
 {
@@ -99,6 +121,14 @@ bool nif::WriteSyncer<nif::NiPSysBoxEmitter>::operator()(const NiPSysBoxEmitter&
 	return true;
 }
 
+bool nif::ChangeSubscriber<nif::NiPSysBoxEmitter>::operator()(NiPSysBoxEmitter& object, ChangeTracker& tracker)
+{
+	tracker.subscribe(object.width);
+	tracker.subscribe(object.height);
+	tracker.subscribe(object.depth);
+	return true;
+}
+
 
 bool nif::ReadSyncer<nif::NiPSysCylinderEmitter>::operator()(NiPSysCylinderEmitter& object, const Niflib::NiPSysCylinderEmitter* native, File& file)
 {
@@ -116,6 +146,13 @@ bool nif::WriteSyncer<nif::NiPSysCylinderEmitter>::operator()(const NiPSysCylind
 	return true;
 }
 
+bool nif::ChangeSubscriber<nif::NiPSysCylinderEmitter>::operator()(NiPSysCylinderEmitter& object, ChangeTracker& tracker)
+{
+	tracker.subscribe(object.radius);
+	tracker.subscribe(object.length);
+	return true;
+}
+
 
 bool nif::ReadSyncer<nif::NiPSysSphereEmitter>::operator()(NiPSysSphereEmitter& object, const Niflib::NiPSysSphereEmitter* native, File& file)
 {
@@ -130,3 +167,9 @@ bool nif::WriteSyncer<nif::NiPSysSphereEmitter>::operator()(const NiPSysSphereEm
 	native->SetRadius(object.radius.get());
 	return true;
 }
+
+bool nif::ChangeSubscriber<nif::NiPSysSphereEmitter>::operator()(NiPSysSphereEmitter& object, ChangeTracker& tracker)
+{
+	tracker.subscribe(object.radius);
+	return true;
+}
@@ -34,6 +34,10 @@ namespace nif
 	{
 		bool operator() (const NiPSysEmitter& object, Niflib::NiPSysEmitter* native, const File& file);
 	};
+	template<> struct ChangeSubscriber<NiPSysEmitter> : VerticalTraverser<NiPSysEmitter, ChangeSubscriber>
+	{
+		bool operator() (NiPSysEmitter& object, ChangeTracker& tracker);
+	};
 
 	//NiPSysVolumeEmitter
 	template<> struct type_map<Niflib::NiPSysVolumeEmitter> { using type = NiPSysVolumeEmitter; };
@@ -47,6 +51,10 @@ namespace nif
 	{
 		bool operator() (const NiPSysVolumeEmitter& object, Niflib::NiPSysVolumeEmitter* native, const File& file);
 	};
+	template<> struct ChangeSubscriber<NiPSysVolumeEmitter> : VerticalTraverser<NiPSysVolumeEmitter, ChangeSubscriber>
+	{
+		bool operator() (NiPSysVolumeEmitter& object, ChangeTracker& tracker);
+	};
 
 	//NiPSysBoxEmitter
 	template<> struct type_map<Niflib::NiPSysBoxEmitter> { using type = NiPSysBoxEmitter; };
@@ -60,6 +68,10 @@ namespace nif
 	{
 		bool operator() (const NiPSysBoxEmitter& object, Niflib::NiPSysBoxEmitter* native, const File& file);
 	};
+	template<> struct ChangeSubscriber<NiPSysBoxEmitter> : VerticalTraverser<NiPSysBoxEmitter, ChangeSubscriber>
+	{
+		bool operator() (NiPSysBoxEmitter& object, ChangeTracker& tracker);
+	};
 
 	//NiPSysCylinderEmitter
 	template<> struct type_map<Niflib::NiPSysCylinderEmitter> { using type = NiPSysCylinderEmitter; };
@@ -73,6 +85,10 @@ namespace nif
 	{
 		bool operator() (const NiPSysCylinderEmitter& object, Niflib::NiPSysCylinderEmitter* native, const File& file);
 	};
+	template<> struct ChangeSubscriber<NiPSysCylinderEmitter> : VerticalTraverser<NiPSysCylinderEmitter, ChangeSubscriber>
+	{
+		bool operator() (NiPSysCylinderEmitter& object, ChangeTracker& tracker);
+	};
 
 	//NiPSysSphereEmitter
 	template<> struct type_map<Niflib::NiPSysSphereEmitter> { using type = NiPSysSphereEmitter; };
@@ -86,4 +102,8 @@ namespace nif
 	{
 		bool operator() (const NiPSysSphereEmitter& object, Niflib::NiPSysSphereEmitter* native, const File& file);
 	};
+	template<> struct ChangeSubscriber<NiPSysSphereEmitter> : VerticalTraverser<NiPSysSphereEmitter, ChangeSubscriber>
+	{
+		bool operator() (NiPSysSphereEmitter& object, ChangeTracker& tracker);
+	};
 }
@@ -30,64 +30,6 @@ const size_t nif::BSPSysSimpleColorModifier::TYPE = std::hash<std::string>{}("BS
 
 using namespace math;
 
-bool nif::ReadSyncer<nif::NiPSysModifier>::operator()(NiPSysModifier& object, const Niflib::NiPSysModifier* native, File& file)
-{
-	assert(native);
-	object.name.set(native->GetName());
-	object.order.set(native->GetOrder());
-	auto target = file.get<NiParticleSystem>(native->GetTarget());
-	file.keepAlive(target);
-	object.target.assign(target);
-	object.active.set(native->GetActive());
-
-	return true;
-}
-
-bool nif::WriteSyncer<nif::NiPSysModifier>::operator()(const NiPSysModifier& object, Niflib::NiPSysModifier* native, const File& file)
-{
-	assert(native);
-	native->SetName(object.name.get());
-	native->SetOrder(object.order.get());
-	native->SetTarget(file.getNative<NiParticleSystem>(object.target.assigned().get()));
-	native->SetActive(object.active.get());
-
-	return true;
-}
-
-
-bool nif::ReadSyncer<nif::NiPSysGravityModifier>::operator()(NiPSysGravityModifier& object, const Niflib::NiPSysGravityModifier* native, File& file)
-{
-	assert(native);
-	auto gravityObject = file.get<NiNode>(native->GetGravityObject());
-	file.keepAlive(gravityObject);
-	object.gravityObject.assign(gravityObject);
-	object.gravityAxis.set(nif_type_conversion<Floats<3>>::from(native->GetGravityAxis()));
-	object.decay.set(native->GetDecay());
-	object.strength.set(native->GetStrength());
-	object.forceType.set(native->GetForceType());
-	object.turbulence.set(native->GetTurbulence());
-	object.turbulenceScale.set(native->GetTurbulenceScale());
-	object.worldAligned.set(native->GetWorldAligned());
-
-	return true;
-}
-
-bool nif::WriteSyncer<nif::NiPSysGravityModifier>::operator()(const NiPSysGravityModifier& object, Niflib::NiPSysGravityModifier* native, const File& file)
-{
-	assert(native);
-	native->SetGravityObject(file.getNative<NiNode>(object.gravityObject.assigned().get()));
-	native->SetGravityAxis(nif_type_conversion<Niflib::Vector3>::from(object.gravityAxis.get()));
-	native->SetDecay(object.decay.get());
-	native->SetStrength(object.strength.get());
-	native->SetForceType(nif_type_conversion<Niflib::ForceType>::from(object.forceType.get()));
-	native->SetTurbulence(object.turbulence.get());
-	native->SetTurbulenceScale(object.turbulenceScale.get());
-	native->SetWorldAligned(object.worldAligned.get());
-
-	return true;
-}
-
-
 bool nif::ReadSyncer<nif::NiPSysRotationModifier>::operator()(NiPSysRotationModifier& object, const Niflib::NiPSysRotationModifier* native, File& file)
 {
 	assert(native);
@@ -112,20 +54,13 @@ bool nif::WriteSyncer<nif::NiPSysRotationModifier>::operator()(const NiPSysRotat
 	return true;
 }
 
-
-bool nif::ReadSyncer<nif::BSPSysScaleModifier>::operator()(BSPSysScaleModifier& object, const Niflib::BSPSysScaleModifier* native, File& file)
+bool nif::ChangeSubscriber<nif::NiPSysRotationModifier>::operator()(NiPSysRotationModifier& object, ChangeTracker& tracker)
 {
-	assert(native);
-	object.scales.set(native->GetScales());
-
-	return true;
-}
-
-bool nif::WriteSyncer<nif::BSPSysScaleModifier>::operator()(const BSPSysScaleModifier& object, Niflib::BSPSysScaleModifier* native, const File& file)
-{
-	assert(native);
-	native->SetScales(object.scales.get());
-
+	tracker.subscribe(object.speed);
+	tracker.subscribe(object.speedVar);
+	tracker.subscribe(object.angle);
+	tracker.subscribe(object.angleVar);
+	tracker.subscribe(object.randomSign);
 	return true;
 }
 
@@ -165,3 +100,17 @@ bool nif::WriteSyncer<nif::BSPSysSimpleColorModifier>::operator()(const BSPSysSi
 
 	return true;
 }
+
+bool nif::ChangeSubscriber<nif::BSPSysSimpleColorModifier>::operator()(BSPSysSimpleColorModifier& object, ChangeTracker& tracker)
+{
+	tracker.subscribe(object.col1.value);
+	tracker.subscribe(object.col1.RGBend);
+	tracker.subscribe(object.col2.value);
+	tracker.subscribe(object.col2.RGBbegin);
+	tracker.subscribe(object.col2.RGBend);
+	tracker.subscribe(object.col2.Abegin);
+	tracker.subscribe(object.col2.Aend);
+	tracker.subscribe(object.col3.value);
+	tracker.subscribe(object.col3.RGBbegin);
+	return true;
+}
@@ -26,13 +26,13 @@ namespace nif
 	template<> struct type_map<Niflib::NiPSysModifier> { using type = NiPSysModifier; };
 	template<> struct type_map<NiPSysModifier> { using type = Niflib::NiPSysModifier; };
 
-	template<> struct ReadSyncer<NiPSysModifier> : VerticalTraverser<NiPSysModifier, ReadSyncer>
+	template<> struct field_table<NiPSysModifier>
 	{
-		bool operator() (NiPSysModifier& object, const Niflib::NiPSysModifier* native, File& file);
-	};
-	template<> struct WriteSyncer<NiPSysModifier> : VerticalTraverser<NiPSysModifier, WriteSyncer>
-	{
-		bool operator() (const NiPSysModifier& object, Niflib::NiPSysModifier* native, const File& file);
+		constexpr static auto fields = std::make_tuple(
+			field(&NiPSysModifier::name, &Niflib::NiPSysModifier::GetName, &Niflib::NiPSysModifier::SetName),
+			field(&NiPSysModifier::order, &Niflib::NiPSysModifier::GetOrder, &Niflib::NiPSysModifier::SetOrder),
+			field(&NiPSysModifier::target, &Niflib::NiPSysModifier::GetTarget, &Niflib::NiPSysModifier::SetTarget),
+			field(&NiPSysModifier::active, &Niflib::NiPSysModifier::GetActive, &Niflib::NiPSysModifier::SetActive));
 	};
 
 	//NiPSysAgeDeathModifier
@@ -47,13 +47,18 @@ namespace nif
 	template<> struct type_map<Niflib::NiPSysGravityModifier> { using type = NiPSysGravityModifier; };
 	template<> struct type_map<NiPSysGravityModifier> { using type = Niflib::NiPSysGravityModifier; };
 
-	template<> struct ReadSyncer<NiPSysGravityModifier> : VerticalTraverser<NiPSysGravityModifier, ReadSyncer>
+	template<> struct field_table<NiPSysGravityModifier>
 	{
-		bool operator() (NiPSysGravityModifier& object, const Niflib::NiPSysGravityModifier* native, File& file);
-	};
-	template<> struct WriteSyncer<NiPSysGravityModifier> : VerticalTraverser<NiPSysGravityModifier, WriteSyncer>
-	{
-		bool operator() (const NiPSysGravityModifier& object, Niflib::NiPSysGravityModifier* native, const File& file);
+		using N = Niflib::NiPSysGravityModifier;
+		constexpr static auto fields = std::make_tuple(
+			field(&NiPSysGravityModifier::gravityObject, &N::GetGravityObject, &N::SetGravityObject),
+			field(&NiPSysGravityModifier::gravityAxis, &N::GetGravityAxis, &N::SetGravityAxis),
+			field(&NiPSysGravityModifier::decay, &N::GetDecay, &N::SetDecay),
+			field(&NiPSysGravityModifier::strength, &N::GetStrength, &N::SetStrength),
+			field(&NiPSysGravityModifier::forceType, &N::GetForceType, &N::SetForceType),
+			field(&NiPSysGravityModifier::turbulence, &N::GetTurbulence, &N::SetTurbulence),
+			field(&NiPSysGravityModifier::turbulenceScale, &N::GetTurbulenceScale, &N::SetTurbulenceScale),
+			field(&NiPSysGravityModifier::worldAligned, &N::GetWorldAligned, &N::SetWorldAligned));
 	};
 
 	//NiPSysPositionModifier
@@ -72,18 +77,19 @@ namespace nif
 	{
 		bool operator() (const NiPSysRotationModifier& object, Niflib::NiPSysRotationModifier* native, const File& file);
 	};
+	template<> struct ChangeSubscriber<NiPSysRotationModifier> : VerticalTraverser<NiPSysRotationModifier, ChangeSubscriber>
+	{
+		bool operator() (NiPSysRotationModifier& object, ChangeTracker& tracker);
+	};
 
 	//BSPSysScaleModifier
 	template<> struct type_map<Niflib::BSPSysScaleModifier> { using type = BSPSysScaleModifier; };
 	template<> struct type_map<BSPSysScaleModifier> { using type = Niflib::BSPSysScaleModifier; };
 
-	template<> struct ReadSyncer<BSPSysScaleModifier> : VerticalTraverser<BSPSysScaleModifier, ReadSyncer>
-	{
-		bool operator() (BSPSysScaleModifier& object, const Niflib::BSPSysScaleModifier* native, File& file);
-	};
-	template<> struct WriteSyncer<BSPSysScaleModifier> : VerticalTraverser<BSPSysScaleModifier, WriteSyncer>
+	template<> struct field_table<BSPSysScaleModifier>
 	{
-		bool operator() (const BSPSysScaleModifier& object, Niflib::BSPSysScaleModifier* native, const File& file);
+		constexpr static auto fields = std::make_tuple(
+			field(&BSPSysScaleModifier::scales, &Niflib::BSPSysScaleModifier::GetScales, &Niflib::BSPSysScaleModifier::SetScales));
 	};
 
 	//BSPSysSimpleColorModifier
@@ -98,4 +104,8 @@ namespace nif
 	{
 		bool operator() (const BSPSysSimpleColorModifier& object, Niflib::BSPSysSimpleColorModifier* native, const File& file);
 	};
+	template<> struct ChangeSubscriber<BSPSysSimpleColorModifier> : VerticalTraverser<BSPSysSimpleColorModifier, ChangeSubscriber>
+	{
+		bool operator() (BSPSysSimpleColorModifier& object, ChangeTracker& tracker);
+	};
 }
@@ -26,18 +26,18 @@ const size_t nif::NiPSysData::TYPE = std::hash<std::string>{}("NiPSysData");
 bool nif::Forwarder<nif::NiParticleSystem>::operator()(NiParticleSystem& object, NiTraverser& traverser)
 {
 	if (auto&& obj = object.data.assigned())
-		obj->receive(traverser);
+		obj->dispatch(traverser);
 
 	for (auto&& obj : object.modifiers) {
 		assert(obj);
-		obj->receive(traverser);
+		obj->dispatch(traverser);
 	}
 
 	if (auto&& obj = object.shaderProperty.assigned())
-		obj->receive(traverser);
+		obj->dispatch(traverser);
 
 	if (auto&& obj = object.alphaProperty.assigned())
-		obj->receive(traverser);
+		obj->dispatch(traverser);
 
 	return true;
 }
@@ -56,6 +56,17 @@ bool nif::ReadSyncer<nif::NiParticleSystem>::operator()(NiParticleSystem& object
 	object.alphaProperty.assign(file.get<NiAlphaProperty>(native->GetAlphaProperty()));
 	object.worldSpace.set(native->GetWorldSpace());
 
+	//We only write what changes, so we can't leave this to the write sync. Correct it on the native
+	//as soon as we see it (new or loaded), it's not one of our fields.
+	//Ideally, this would be done at construction of the native. We never change it.
+	const_cast<Niflib::NiParticleSystem*>(native)->GetVertexDescriptor().bitfield = 0x840200004000051;//BS use this for psys'
+	//Corresponding to this:
+	//getNative().GetVertexDescriptor().SetVertexDataSize(1);
+	//getNative().GetVertexDescriptor().SetDynamicVertexSize(5);
+	//getNative().GetVertexDescriptor().SetColorOffset(4);
+	//getNative().GetVertexDescriptor().SetVertexAttributes(Niflib::VF_UVS | Niflib::VF_FULL_PRECISION);
+	//getNative().GetVertexDescriptor().SetUnknown02(8);//unclear if this does anything
+
 	return true;
 }
 
@@ -80,18 +91,21 @@ bool nif::WriteSyncer<nif::NiParticleSystem>::operator()(const NiParticleSystem&
 	native->SetAlphaProperty(file.getNative<NiAlphaProperty>(object.alphaProperty.assigned().get()));
 	native->SetWorldSpace(object.worldSpace.get());
 
-	//Ideally, this would be done at construction of the native. We never change it.
-	native->GetVertexDescriptor().bitfield = 0x840200004000051;//BS use this for psys'
-	//Corresponding to this:
-	//getNative().GetVertexDescriptor().SetVertexDataSize(1);
-	//getNative().GetVertexDescriptor().SetDynamicVertexSize(5);
-	//getNative().GetVertexDescriptor().SetColorOffset(4);
-	//getNative().GetVertexDescriptor().SetVertexAttributes(Niflib::VF_UVS | Niflib::VF_FULL_PRECISION);
-	//getNative().GetVertexDescriptor().SetUnknown02(8);//unclear if this does anything
+	//The vertex descriptor was set by the read sync
 
 	return true;
 }
 
+bool nif::ChangeSubscriber<nif::NiParticleSystem>::operator()(NiParticleSystem& object, ChangeTracker& tracker)
+{
+	tracker.subscribe(object.data);
+	tracker.subscribe(object.modifiers);
+	tracker.subscribe(object.shaderProperty);
+	tracker.subscribe(object.alphaProperty);
+	tracker.subscribe(object.worldSpace);
+	return true;
+}
+
 bool nif::ReadSyncer<nif::NiPSysData>::operator()(NiPSysData& object, const Niflib::NiPSysData* native, File& file)
 {
 	assert(native);
@@ -115,7 +129,7 @@ bool nif::WriteSyncer<nif::NiPSysData>::operator()(const NiPSysData& object, Nif
 	assert(native);
 	native->SetBSMaxVertices(object.maxCount.get());
 
-	auto&& offsets1 = object.subtexOffsets.get();//Copy. Should we add a const ref getter to Property?
+	auto&& offsets1 = object.subtexOffsets.view();
 	auto&& offsets2 = native->GetSubtextureOffsets();
 	offsets2.resize(offsets1.size());
 	for (size_t i = 0; i < offsets1.size(); i++)
@@ -127,3 +141,13 @@ bool nif::WriteSyncer<nif::NiPSysData>::operator()(const NiPSysData& object, Nif
 
 	return true;
 }
+
+bool nif::ChangeSubscriber<nif::NiPSysData>::operator()(NiPSysData& object, ChangeTracker& tracker)
+{
+	tracker.subscribe(object.maxCount);
+	tracker.subscribe(object.subtexOffsets);
+	tracker.subscribe(object.hasColour);
+	tracker.subscribe(object.hasRotationAngles);
+	tracker.subscribe(object.hasRotationSpeeds);
+	return true;
+}
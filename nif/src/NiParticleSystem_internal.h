@@ -34,6 +34,10 @@ namespace nif
 	{
 		bool operator() (const NiParticleSystem& object, Niflib::NiParticleSystem* native, const File& file);
 	};
+	template<> struct ChangeSubscriber<NiParticleSystem> : VerticalTraverser<NiParticleSystem, ChangeSubscriber>
+	{
+		bool operator() (NiParticleSystem& object, ChangeTracker& tracker);
+	};
 
 	//NiPSysData
 	template<> struct type_map<Niflib::NiPSysData> { using type = NiPSysData; };
@@ -46,4 +50,8 @@ namespace nif
 	{
 		bool operator() (const NiPSysData& object, Niflib::NiPSysData* native, const File& file);
 	};
+	template<> struct ChangeSubscriber<NiPSysData> : VerticalTraverser<NiPSysData, ChangeSubscriber>
+	{
+		bool operator() (NiPSysData& object, ChangeTracker& tracker);
+	};
 }
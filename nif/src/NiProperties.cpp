@@ -50,6 +50,17 @@ bool nif::WriteSyncer<nif::NiAlphaProperty>::operator() (const NiAlphaProperty&
 	return true;
 }
 
+bool nif::ChangeSubscriber<nif::NiAlphaProperty>::operator()(NiAlphaProperty& object, ChangeTracker& tracker)
+{
+	tracker.subscribe(object.mode);
+	tracker.subscribe(object.srcFcn);
+	tracker.subscribe(object.dstFcn);
+	tracker.subscribe(object.testFcn);
+	tracker.subscribe(object.noSorting);
+	tracker.subscribe(object.threshold);
+	return true;
+}
+
 bool nif::ReadSyncer<nif::BSEffectShaderProperty>::operator()(BSEffectShaderProperty& object, const Niflib::BSEffectShaderProperty* native, File& file)
 {
 	assert(native);
@@ -70,10 +81,21 @@ bool nif::WriteSyncer<nif::BSEffectShaderProperty>::operator()(const BSEffectSha
 	assert(native);
 	native->SetEmissiveColor(nif_type_conversion<Niflib::Color4>::from(object.emissiveCol.get()));
 	native->SetEmissiveMultiple(object.emissiveMult.get());
-	native->SetSourceTexture(object.sourceTex.get());
-	native->SetGreyscaleTexture(object.greyscaleTex.get());
+	native->SetSourceTexture(object.sourceTex.view());
+	native->SetGreyscaleTexture(object.greyscaleTex.view());
 	native->SetShaderFlags1(nif_type_conversion<Niflib::SkyrimShaderPropertyFlags1>::from(object.shaderFlags1.raised()));
 	native->SetShaderFlags2(nif_type_conversion<Niflib::SkyrimShaderPropertyFlags2>::from(object.shaderFlags2.raised()));
 
 	return true;
 }
+
+bool nif::ChangeSubscriber<nif::BSEffectShaderProperty>::operator()(BSEffectShaderProperty& object, ChangeTracker& tracker)
+{
+	tracker.subscribe(object.emissiveCol);
+	tracker.subscribe(object.emissiveMult);
+	tracker.subscribe(object.sourceTex);
+	tracker.subscribe(object.greyscaleTex);
+	tracker.subscribe(object.shaderFlags1);
+	tracker.subscribe(object.shaderFlags2);
+	return true;
+}
@@ -37,6 +37,10 @@ namespace nif
 	{
 		bool operator() (const NiAlphaProperty& object, Niflib::NiAlphaProperty* native, const File& file);
 	};
+	template<> struct ChangeSubscriber<NiAlphaProperty> : VerticalTraverser<NiAlphaProperty, ChangeSubscriber>
+	{
+		bool operator() (NiAlphaProperty& object, ChangeTracker& tracker);
+	};
 
 	//BSShaderProperty
 	template<> struct type_map<Niflib::BSShaderProperty> { using type = BSShaderProperty; };
@@ -53,4 +57,8 @@ namespace nif
 	{
 		bool operator() (const BSEffectShaderProperty& object, Niflib::BSEffectShaderProperty* native, const File& file);
 	};
+	template<> struct ChangeSubscriber<BSEffectShaderProperty> : VerticalTraverser<BSEffectShaderProperty, ChangeSubscriber>
+	{
+		bool operator() (BSEffectShaderProperty& object, ChangeTracker& tracker);
+	};
 }
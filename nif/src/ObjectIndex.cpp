@@ -0,0 +1,150 @@
+//Copyright 2021 Jonas Gernandt
+//
+//This file is part of SVFX Editor, a program for creating visual effects
+//in the NetImmerse format.
+//
+//SVFX Editor is free software: you can redistribute it and/or modify
+//it under the terms of the GNU General Public License as published by
+//the Free Software Foundation, either version 3 of the License, or
+//(at your option) any later version.
+//
+//SVFX Editor is distributed in the hope that it will be useful,
+//but WITHOUT ANY WARRANTY; without even the implied warranty of
+//MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//GNU General Public License for more details.
+//
+//You should have received a copy of the GNU General Public License
+//along with SVFX Editor. If not, see <https://www.gnu.org/licenses/>.
+
+#include "pch.h"
+#include "ObjectIndex.h"
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+constexpr size_t MIN_CAPACITY = 64;
+
+namespace
+{
+	//Fibonacci hashing of an address. The low bits of heap addresses carry no information.
+	inline size_t hashAddress(const void* p, size_t mask)
+	{
+		std::uint64_t h = static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(p) >> 4);
+		return static_cast<size_t>((h * 0x9E3779B97F4A7C15ull) >> 32) & mask;
+	}
+}
+
+template<typename KeyFcn>
+nif::ObjectIndex::index_type nif::ObjectIndex::find(const std::vector<index_type>& table, const void* key, KeyFcn keyOf) const
+{
+	if (table.empty() || !key)
+		return EMPTY;
+
+	size_t mask = table.size() - 1;
+	for (size_t slot = hashAddress(key, mask);; slot = (slot + 1) & mask) {
+		index_type i = table[slot];
+		if (i == EMPTY)
+			return EMPTY;
+		else if (keyOf(m_entries[i]) == key)
+			return i;
+	}
+}
+
+void nif::ObjectIndex::insert(const std::shared_ptr<NiObject>& object, Niflib::NiObject* native)
+{
+	assert(object && native);
+
+	//If either address is indexed, it has been reused since that object expired
+	if (index_type i = find(m_byObject, object.get(), [](const Entry& e) { return e.object; }); i != EMPTY) {
+		assert(m_entries[i].weak.expired());
+		remove(i);
+	}
+	if (index_type i = find(m_byNative, native, [](const Entry& e) { return e.native; }); i != EMPTY) {
+		assert(m_entries[i].weak.expired());
+		remove(i);
+	}
+
+	//Keep the load factor at most 1/2
+	if (2 * (m_entries.size() + 1) > m_byObject.size()) {
+		size_t live = 0;
+		for (auto&& e : m_entries)
+			if (e.object && !e.weak.expired())
+				live++;
+
+		//Grow if the table would still be more than 1/4 full without the dead entries
+		size_t capacity = std::max(m_byObject.size(), MIN_CAPACITY);
+		while (4 * (live + 1) > capacity)
+			capacity *= 2;
+		rebuild(capacity);
+	}
+
+	if (m_entries.size() >= std::numeric_limits<index_type>::max())
+		throw std::length_error("Too many objects");
+
+	m_entries.push_back({ object.get(), native, object });
+	link(static_cast<index_type>(m_entries.size() - 1));
+}
+
+void nif::ObjectIndex::erase(const Niflib::NiObject* native)
+{
+	if (index_type i = find(m_byNative, native, [](const Entry& e) { return e.native; }); i != EMPTY)
+		remove(i);
+}
+
+const nif::ObjectIndex::Entry* nif::ObjectIndex::findObject(const NiObject* object) const
+{
+	index_type i = find(m_byObject, object, [](const Entry& e) { return e.object; });
+	return i == EMPTY ? nullptr : &m_entries[i];
+}
+
+const nif::ObjectIndex::Entry* nif::ObjectIndex::findNative(const Niflib::NiObject* native) const
+{
+	index_type i = find(m_byNative, native, [](const Entry& e) { return e.native; });
+	return i == EMPTY ? nullptr : &m_entries[i];
+}
+
+void nif::ObjectIndex::remove(index_type i)
+{
+	//Clearing the keys makes the entry invisible to lookups, but its slots still
+	//occupy the probe sequences of other entries until we rebuild.
+	m_entries[i] = Entry();
+	m_removed++;
+}
+
+void nif::ObjectIndex::rebuild(size_t capacity)
+{
+	assert(capacity && (capacity & (capacity - 1)) == 0);
+
+	//Drop entries that have been removed or whose objects have expired
+	size_t next = 0;
+	for (size_t i = 0; i < m_entries.size(); i++) {
+		if (m_entries[i].object && !m_entries[i].weak.expired()) {
+			if (next != i)
+				m_entries[next] = std::move(m_entries[i]);
+			next++;
+		}
+	}
+	m_entries.resize(next);
+	m_removed = 0;
+
+	m_byObject.assign(capacity, EMPTY);
+	m_byNative.assign(capacity, EMPTY);
+	for (size_t i = 0; i < m_entries.size(); i++)
+		link(static_cast<index_type>(i));
+}
+
+void nif::ObjectIndex::link(index_type i)
+{
+	size_t mask = m_byObject.size() - 1;
+
+	size_t slot = hashAddress(m_entries[i].object, mask);
+	while (m_byObject[slot] != EMPTY)
+		slot = (slot + 1) & mask;
+	m_byObject[slot] = i;
+
+	slot = hashAddress(m_entries[i].native, mask);
+	while (m_byNative[slot] != EMPTY)
+		slot = (slot + 1) & mask;
+	m_byNative[slot] = i;
+}
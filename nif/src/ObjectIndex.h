@@ -0,0 +1,95 @@
+//Copyright 2021 Jonas Gernandt
+//
+//This file is part of SVFX Editor, a program for creating visual effects
+//in the NetImmerse format.
+//
+//SVFX Editor is free software: you can redistribute it and/or modify
+//it under the terms of the GNU General Public License as published by
+//the Free Software Foundation, either version 3 of the License, or
+//(at your option) any later version.
+//
+//SVFX Editor is distributed in the hope that it will be useful,
+//but WITHOUT ANY WARRANTY; without even the implied warranty of
+//MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//GNU General Public License for more details.
+//
+//You should have received a copy of the GNU General Public License
+//along with SVFX Editor. If not, see <https://www.gnu.org/licenses/>.
+
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace Niflib
+{
+	class NiObject;
+}
+
+namespace nif
+{
+	struct NiObject;
+
+	//Maps our objects to their Niflib objects and back.
+	//Entries are stored contiguously and looked up through two open addressing hash tables
+	//of entry indices, so lookups are O(1) and inserting does not allocate per entry.
+	//Entries of expired objects are left in place until the tables are rebuilt.
+	class ObjectIndex
+	{
+	public:
+		struct Entry
+		{
+			const NiObject* object{ nullptr };
+			Niflib::NiObject* native{ nullptr };
+			//The native is owned by the same block as the object
+			std::weak_ptr<NiObject> weak;
+		};
+
+	public:
+		ObjectIndex() = default;
+		ObjectIndex(const ObjectIndex&) = delete;
+		~ObjectIndex() = default;
+
+		ObjectIndex& operator=(const ObjectIndex&) = delete;
+
+		//Any existing entry for either address must have expired, and will be replaced
+		void insert(const std::shared_ptr<NiObject>& object, Niflib::NiObject* native);
+
+		//Removes the entry of native, if it has one
+		void erase(const Niflib::NiObject* native);
+
+		//Returns null if the address is not indexed
+		const Entry* findObject(const NiObject* object) const;
+		const Entry* findNative(const Niflib::NiObject* native) const;
+
+		//Number of entries, including expired ones
+		size_t size() const { return m_entries.size() - m_removed; }
+
+		//Calls f with each entry whose object has not expired
+		template<typename Fcn>
+		void forEachLive(Fcn&& f) const
+		{
+			for (auto&& e : m_entries)
+				if (e.object && !e.weak.expired())
+					f(e);
+		}
+
+	private:
+		using index_type = std::uint32_t;
+		constexpr static index_type EMPTY = ~index_type(0);
+
+		template<typename KeyFcn>
+		index_type find(const std::vector<index_type>& table, const void* key, KeyFcn keyOf) const;
+
+		void remove(index_type i);
+		void rebuild(size_t capacity);
+		void link(index_type i);
+
+	private:
+		std::vector<Entry> m_entries;
+		std::vector<index_type> m_byObject;
+		std::vector<index_type> m_byNative;
+		//Entries that have been replaced, but not yet erased
+		size_t m_removed{ 0 };
+	};
+}
@@ -0,0 +1,59 @@
+//Copyright 2021 Jonas Gernandt
+//
+//This file is part of SVFX Editor, a program for creating visual effects
+//in the NetImmerse format.
+//
+//SVFX Editor is free software: you can redistribute it and/or modify
+//it under the terms of the GNU General Public License as published by
+//the Free Software Foundation, either version 3 of the License, or
+//(at your option) any later version.
+//
+//SVFX Editor is distributed in the hope that it will be useful,
+//but WITHOUT ANY WARRANTY; without even the implied warranty of
+//MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//GNU General Public License for more details.
+//
+//You should have received a copy of the GNU General Public License
+//along with SVFX Editor. If not, see <https://www.gnu.org/licenses/>.
+
+
+#include "pch.h"
+#include "ObjectTable.h"
+
+#include <unordered_set>
+
+namespace
+{
+	class TableBuilder final : public nif::HorizontalTraverser<TableBuilder>
+	{
+	public:
+		TableBuilder(std::vector<nif::ObjectTable::Entry>& entries) : m_entries{ entries } {}
+
+		template<typename T>
+		void invoke(T& object)
+		{
+			//Shared objects are recorded (and forwarded) the first time we reach them
+			if (m_seen.insert(&object).second) {
+				int parent = m_parent;
+				m_parent = static_cast<int>(m_entries.size());
+				m_entries.push_back({ &object, T::TYPE, parent });
+
+				nif::Forwarder<T>{}.down(object, *this);
+
+				m_parent = parent;
+			}
+		}
+
+	private:
+		std::vector<nif::ObjectTable::Entry>& m_entries;
+		std::unordered_set<const nif::NiObject*> m_seen;
+		int m_parent{ -1 };
+	};
+}
+
+void nif::ObjectTable::build(NiObject& root)
+{
+	m_entries.clear();
+	TableBuilder builder(m_entries);
+	root.dispatch(builder);
+}
@@ -0,0 +1,68 @@
+//Copyright 2021 Jonas Gernandt
+//
+//This file is part of SVFX Editor, a program for creating visual effects
+//in the NetImmerse format.
+//
+//SVFX Editor is free software: you can redistribute it and/or modify
+//it under the terms of the GNU General Public License as published by
+//the Free Software Foundation, either version 3 of the License, or
+//(at your option) any later version.
+//
+//SVFX Editor is distributed in the hope that it will be useful,
+//but WITHOUT ANY WARRANTY; without even the implied warranty of
+//MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//GNU General Public License for more details.
+//
+//You should have received a copy of the GNU General Public License
+//along with SVFX Editor. If not, see <https://www.gnu.org/licenses/>.
+
+
+#pragma once
+#include <vector>
+#include "nif_objects.h"
+
+namespace nif
+{
+	//Every object reachable from a root, once each, in the order that a forwarding traverser first
+	//reaches them. An object comes after its parent (the object that first reached it), but a shared
+	//object may come before its other parents. Stored contiguously, so that a pass over
+	//all objects is a loop instead of a recursion through receive and the Forwarders.
+	class ObjectTable
+	{
+	public:
+		struct Entry
+		{
+			NiObject* object{ nullptr };
+			ni_type type{ 0 };
+			//Index of the object that forwarded to us, -1 for the root
+			int parent{ -1 };
+		};
+
+	public:
+		ObjectTable() = default;
+		ObjectTable(const ObjectTable&) = delete;
+		~ObjectTable() = default;
+
+		ObjectTable& operator=(const ObjectTable&) = delete;
+
+		void build(NiObject& root);
+		void clear() { m_entries.clear(); }
+
+		size_t size() const { return m_entries.size(); }
+		bool empty() const { return m_entries.empty(); }
+		const Entry& operator[](size_t i) const { return m_entries[i]; }
+
+		std::vector<Entry>::const_iterator begin() const { return m_entries.begin(); }
+		std::vector<Entry>::const_iterator end() const { return m_entries.end(); }
+
+		//Send traverser to each object, in order. It should not forward.
+		void traverse(NiTraverser& traverser) const
+		{
+			for (auto&& entry : m_entries)
+				entry.object->dispatch(traverser);
+		}
+
+	private:
+		std::vector<Entry> m_entries;
+	};
+}
@@ -0,0 +1,103 @@
+//Copyright 2021 Jonas Gernandt
+//
+//This file is part of SVFX Editor, a program for creating visual effects
+//in the NetImmerse format.
+//
+//SVFX Editor is free software: you can redistribute it and/or modify
+//it under the terms of the GNU General Public License as published by
+//the Free Software Foundation, either version 3 of the License, or
+//(at your option) any later version.
+//
+//SVFX Editor is distributed in the hope that it will be useful,
+//but WITHOUT ANY WARRANTY; without even the implied warranty of
+//MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//GNU General Public License for more details.
+//
+//You should have received a copy of the GNU General Public License
+//along with SVFX Editor. If not, see <https://www.gnu.org/licenses/>.
+
+
+#pragma once
+#include <cassert>
+#include <vector>
+#include "ObjectTable.h"
+
+namespace nif
+{
+	//A pass that knows where in the table the object it is receiving sits
+	class PipelinePass : public NiTraverser
+	{
+	public:
+		virtual ~PipelinePass() = default;
+
+	protected:
+		const ObjectTable& table() const { assert(m_table); return *m_table; }
+		size_t index() const { return m_index; }
+		const ObjectTable::Entry& entry() const { return table()[m_index]; }
+
+	private:
+		friend class Pipeline;
+		const ObjectTable* m_table{ nullptr };
+		size_t m_index{ 0 };
+	};
+
+	//Runs several passes in one walk over an ObjectTable, instead of one walk per pass.
+	//A pass is a traverser that doesn't forward. Every pass is done with an object before the
+	//next pass receives it, in the order they were added.
+	//Passes may change references as they go, but must not destroy objects they haven't reached.
+	class Pipeline
+	{
+	public:
+		enum class Order
+		{
+			//The order of the table
+			PARENTS_FIRST,
+			//Reverse order. An object is done before its parent in the table (the object that first
+			//reached it), and so before everything on the table's path from the root to it. The root
+			//is reached last. An object that is shared may still be reached after one of its other
+			//parents, if that comes later in the table.
+			CHILDREN_FIRST,
+		};
+
+	public:
+		Pipeline(Order order = Order::PARENTS_FIRST) : m_order{ order } {}
+
+		void add(NiTraverser& pass) { m_passes.push_back({ &pass, nullptr }); }
+		void add(PipelinePass& pass) { m_passes.push_back({ &pass, &pass }); }
+
+		Order order() const { return m_order; }
+
+		void run(const ObjectTable& table) const
+		{
+			if (m_order == Order::PARENTS_FIRST) {
+				for (size_t i = 0; i < table.size(); i++)
+					visit(table, i);
+			}
+			else {
+				for (size_t i = table.size(); i > 0; i--)
+					visit(table, i - 1);
+			}
+		}
+
+	private:
+		void visit(const ObjectTable& table, size_t i) const
+		{
+			for (auto&& pass : m_passes) {
+				if (pass.context) {
+					pass.context->m_table = &table;
+					pass.context->m_index = i;
+				}
+				table[i].object->dispatch(*pass.traverser);
+			}
+		}
+
+	private:
+		struct Pass
+		{
+			NiTraverser* traverser;
+			PipelinePass* context;
+		};
+		std::vector<Pass> m_passes;
+		Order m_order;
+	};
+}
@@ -0,0 +1,66 @@
+//Copyright 2021 Jonas Gernandt
+//
+//This file is part of SVFX Editor, a program for creating visual effects
+//in the NetImmerse format.
+//
+//SVFX Editor is free software: you can redistribute it and/or modify
+//it under the terms of the GNU General Public License as published by
+//the Free Software Foundation, either version 3 of the License, or
+//(at your option) any later version.
+//
+//SVFX Editor is distributed in the hope that it will be useful,
+//but WITHOUT ANY WARRANTY; without even the implied warranty of
+//MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//GNU General Public License for more details.
+//
+//You should have received a copy of the GNU General Public License
+//along with SVFX Editor. If not, see <https://www.gnu.org/licenses/>.
+
+
+#include "pch.h"
+#include "Probe.h"
+#include "Header.h"
+
+#include <stdexcept>
+
+//Most headers fit in the first read
+constexpr size_t PROBE_READ_SIZE = 4096;
+
+nif::ProbeResult nif::probe(const std::filesystem::path& path)
+{
+	std::ifstream in(path, std::ifstream::binary);
+	if (!in)
+		throw std::runtime_error("Failed to open file");
+
+	//Read until we have the whole header, growing the read if it is larger than expected
+	std::vector<char> buf;
+	Header header;
+	for (size_t readSize = PROBE_READ_SIZE;; readSize *= 4) {
+		size_t offset = buf.size();
+		buf.resize(readSize);
+		in.read(buf.data() + offset, static_cast<std::streamsize>(readSize - offset));
+		buf.resize(offset + static_cast<size_t>(in.gcount()));
+
+		if (readHeader(buf.data(), buf.size(), header))//may throw
+			break;
+		else if (!in)
+			throw std::runtime_error("Unexpected end of file");
+	}
+
+	ProbeResult result;
+	result.version = header.fileVersion();
+	result.creator = std::move(header.creator);
+	result.exportInfo1 = std::move(header.exportInfo1);
+	result.exportInfo2 = std::move(header.exportInfo2);
+
+	std::vector<unsigned int> counts(header.blockTypes.size(), 0);
+	for (unsigned short index : header.blockTypeIndex)
+		counts.at(index)++;//readHeader has validated the indices
+	for (size_t i = 0; i < counts.size(); i++) {
+		if (counts[i])
+			result.blockTypes[header.blockTypes[i]] += counts[i];
+	}
+	result.blockCount = header.blockCount();
+
+	return result;
+}
@@ -0,0 +1,48 @@
+//Copyright 2021 Jonas Gernandt
+//
+//This file is part of SVFX Editor, a program for creating visual effects
+//in the NetImmerse format.
+//
+//SVFX Editor is free software: you can redistribute it and/or modify
+//it under the terms of the GNU General Public License as published by
+//the Free Software Foundation, either version 3 of the License, or
+//(at your option) any later version.
+//
+//SVFX Editor is distributed in the hope that it will be useful,
+//but WITHOUT ANY WARRANTY; without even the implied warranty of
+//MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//GNU General Public License for more details.
+//
+//You should have received a copy of the GNU General Public License
+//along with SVFX Editor. If not, see <https://www.gnu.org/licenses/>.
+
+
+#pragma once
+#include <filesystem>
+#include <map>
+#include <string>
+
+#include "File.h"
+
+namespace nif
+{
+	//What a nif file contains, as told by its header
+	struct ProbeResult
+	{
+		File::Version version{ File::Version::UNKNOWN };
+
+		//Same names as in Niflib::NifInfo
+		std::string creator;
+		std::string exportInfo1;
+		std::string exportInfo2;
+
+		//Number of blocks of each type, by type name
+		std::map<std::string, unsigned int> blockTypes;
+		size_t blockCount{ 0 };
+	};
+
+	//Read the header of a nif file, without decoding any blocks.
+	//Reads no more of the file than the header occupies (rounded up to a few KB).
+	//Throws std::runtime_error if the file cannot be read or is not a nif file we can decode.
+	[[nodiscard]] ProbeResult probe(const std::filesystem::path& path);
+}
@@ -18,6 +18,9 @@
 
 #pragma once
 #include <cassert>
+#include <memory>
+#include <utility>
+#include <vector>
 #include "Observable.h"
 
 namespace nif
@@ -28,6 +31,9 @@ namespace nif
 	struct Event<Property<T>>
 	{
 		const T& value;
+		//The value before, or null if we don't know it. We don't if the event sums up several sets
+		//held back by a ChangeBatch, and the value is too large for the batch to keep.
+		const T* previous{ nullptr };
 	};
 
 	template<typename T>
@@ -36,7 +42,7 @@ namespace nif
 	public:
 		virtual ~IListener() = default;
 
-		void receive(const Event<nif::Property<T>>& e, Observable<nif::Property<T>>&)
+		virtual void receive(const Event<nif::Property<T>>& e, Observable<nif::Property<T>>&)
 		{ 
 			onSet(e.value); 
 		}
@@ -45,16 +51,36 @@ namespace nif
 
 	template<typename T> using PropertyListener = IListener<Property<T>>;
 
+	//Only the final value of a Property matters to its listeners
+	template<typename T>
+	struct LatestEvent<Property<T>>
+	{
+		static Event<nif::Property<T>> get(const nif::Property<T>& p, const void* before)
+		{
+			return { p.view(), static_cast<const T*>(before) };
+		}
+	};
+
+	//Properties of these types hold their value as an immutable, shared snapshot. Anyone who needs
+	//to keep a value around (like an undo command) can share it instead of copying it.
+	template<typename T> struct is_snapshot_type : std::false_type {};
+	template<typename T, typename A> struct is_snapshot_type<std::vector<T, A>> : std::true_type {};
+
 	template<typename T>
 	class Property final : public Observable<Property<T>>
 	{
+		friend struct LatestEvent<Property<T>>;
+
+		constexpr static bool SNAPSHOT = is_snapshot_type<T>::value;
+
 	public:
 		using value_type = T;
+		using snapshot_type = std::shared_ptr<const T>;
 
 	public:
-		Property(const T& val = T()) : m_value{ val } {}
+		Property(const T& val = T()) : m_value{ store(val) } {}
 		Property(const Property<T>&) = delete;
-		Property(Property<T>&& other) noexcept { *this = std::move(other); }
+		Property(Property<T>&& other) noexcept : m_value{ initial() } { *this = std::move(other); }
 
 		~Property() = default;
 
@@ -64,33 +90,104 @@ namespace nif
 			static_assert(std::is_nothrow_move_assignable<T>::value);
 
 			Observable<Property<T>>::operator=(std::move(other));
-			m_value = std::move(other.m_value);
+			if constexpr (SNAPSHOT)
+				//other must still have a value
+				m_value.swap(other.m_value);
+			else
+				m_value = std::move(other.m_value);
 			return *this;
 		}
 
 		T get() const
 		{
-			return m_value;
+			return view();
+		}
+		//Read without copying. The reference is to our current value, so it is only good until we
+		//are next set, moved from or destroyed. Copy it (or use get) if you need to hold on to it
+		//across anything that might set us, including calls to our listeners.
+		const T& view() const
+		{
+			if constexpr (SNAPSHOT)
+				return *m_value;
+			else
+				return m_value;
 		}
 		void set(const T& val)
 		{
-			if (val != m_value) {
-				m_value = val;
-				this->signal(Event<Property<T>>{ m_value });
-			}
+			if (val != view())
+				signalSet(std::exchange(m_value, store(val)));
 		}
 		void set(T&& val)
 		{
-			if (val != m_value) {
-				m_value = std::move(val);
-				this->signal(Event<Property<T>>{ m_value });
-			}
+			if (val != view())
+				signalSet(std::exchange(m_value, store(std::move(val))));
 			else
 				//Disard val? Inconsistent otherwise?
 				T tmp = std::move(val);
 		}
 
+		//Our current value, shared. It will never change, so it stays valid after we are set.
+		//Only for snapshot types.
+		snapshot_type snapshot() const
+		{
+			static_assert(SNAPSHOT, "not a snapshot type");
+			return m_value;
+		}
+		//Take a shared value. Doesn't copy, and doesn't compare values, only whether we already
+		//hold this snapshot. Only for snapshot types.
+		void set(const snapshot_type& val)
+		{
+			static_assert(SNAPSHOT, "not a snapshot type");
+			assert(val);
+			if (val != m_value)
+				signalSet(std::exchange(m_value, val));
+		}
+
+	private:
+		using storage_type = std::conditional_t<SNAPSHOT, snapshot_type, T>;
+
+		//Signal our new value, and the one we had before
+		void signalSet(const storage_type& old)
+		{
+			const T* previous;
+			if constexpr (SNAPSHOT)
+				previous = old.get();
+			else
+				previous = &old;
+
+			//A batch can keep small values, for when it signals later
+			if constexpr (ObservableBatch::can_hold<T>)
+				this->signalLatest(Event<Property<T>>{ view(), previous }, previous);
+			else
+				this->signalLatest(Event<Property<T>>{ view(), previous });
+		}
+
+		//Moved-from snapshot Properties hold a default value, shared by all of them
+		static auto initial() noexcept
+		{
+			if constexpr (SNAPSHOT) {
+				static const snapshot_type s_default = std::make_shared<const T>();
+				return s_default;
+			}
+			else
+				return T();
+		}
+
+		template<typename V>
+		static auto store(V&& val)
+		{
+			if constexpr (SNAPSHOT)
+				return std::make_shared<const T>(std::forward<V>(val));
+			else
+				return T(std::forward<V>(val));
+		}
+
 	private:
-		T m_value{ T() };
+		storage_type m_value;
 	};
+
+	//Holds back Property signals until the outermost ChangeBatch on this thread ends, and
+	//delivers one signal per Property with its final value. Use it around any bulk change to
+	//spare listeners the intermediate states.
+	using ChangeBatch = ObservableBatch;
 }
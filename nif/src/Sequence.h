@@ -19,6 +19,7 @@
 #pragma once
 #include <cassert>
 #include <memory>
+#include <unordered_map>
 #include <vector>
 #include "Observable.h"
 
@@ -35,8 +36,11 @@ namespace nif
 		enum {
 			INSERT,
 			ERASE,
+			INSERT_RANGE,
+			ERASE_RANGE,
 		} type{ INSERT };
 		int pos{ -1 };
+		int count{ 1 };//number of elements, for ranges
 	};
 
 	template<typename T>
@@ -45,7 +49,7 @@ namespace nif
 	public:
 		virtual ~IListener() = default;
 
-		void receive(const Event<nif::Sequence<T>>&e, Observable<nif::Sequence<T>>&)
+		virtual void receive(const Event<nif::Sequence<T>>&e, Observable<nif::Sequence<T>>&)
 		{
 			switch (e.type) {
 			case Event<nif::Sequence<T>>::INSERT:
@@ -54,11 +58,29 @@ namespace nif
 			case Event<nif::Sequence<T>>::ERASE:
 				onErase(e.pos);
 				break;
+			case Event<nif::Sequence<T>>::INSERT_RANGE:
+				onInsertRange(e.pos, e.count);
+				break;
+			case Event<nif::Sequence<T>>::ERASE_RANGE:
+				onEraseRange(e.pos, e.count);
+				break;
 			}
 		}
 
 		virtual void onInsert(int) {}
 		virtual void onErase(int) {}
+
+		//count elements were inserted/erased starting at pos. Override to handle them in one go.
+		virtual void onInsertRange(int pos, int count)
+		{
+			for (int i = 0; i < count; i++)
+				onInsert(pos + i);
+		}
+		virtual void onEraseRange(int pos, int count)
+		{
+			for (int i = count - 1; i >= 0; i--)
+				onErase(pos + i);
+		}
 	};
 
 	template<typename T> using SequenceListener = IListener<Sequence<T>>;
@@ -104,8 +126,9 @@ namespace nif
 
 			if (obj) {
 				i = std::min((size_t)i, m_ctnr.size());
-				if (auto it = std::find(m_ctnr.begin(), m_ctnr.end(), obj); it == m_ctnr.end()) {
+				if (int current = find(obj.get()); current == -1) {
 					m_ctnr.insert(m_ctnr.begin() + i, obj);
+					indexInserted(i, 1);
 
 					this->signal(Event<Sequence<T>>{ Event<Sequence<T>>::INSERT, i });
 
@@ -113,29 +136,72 @@ namespace nif
 				}
 				else
 					//If already in the sequence, do not move. Return current location. Do not call listeners.
-					return std::distance(m_ctnr.begin(), it);
+					return current;
 			}
 			else
 				return -1;
 		}
+		//Inserts the objects that are not null or already in the sequence, in order, before i.
+		//Returns the number inserted.
+		int insert(int i, const std::vector<std::shared_ptr<T>>& objs)
+		{
+			assert(i >= 0);
+
+			i = std::min((size_t)i, m_ctnr.size());
+
+			ctnr_type added;
+			for (auto&& obj : objs) {
+				//Mark as a member before we insert, to catch duplicates in objs
+				if (obj && m_index.emplace(obj.get(), -1).second)
+					added.push_back(obj);
+			}
+
+			if (!added.empty()) {
+				m_ctnr.insert(m_ctnr.begin() + i, added.begin(), added.end());
+				indexInserted(i, static_cast<int>(added.size()));
+
+				this->signal(Event<Sequence<T>>{ Event<Sequence<T>>::INSERT_RANGE, i, static_cast<int>(added.size()) });
+			}
+
+			return static_cast<int>(added.size());
+		}
 		int erase(int i)
 		{
 			assert(i >= 0 && (size_t)i < m_ctnr.size());
 
+			indexErased(i, 1);
 			m_ctnr.erase(m_ctnr.begin() + i);
 
-
 			this->signal(Event<Sequence<T>>{ Event<Sequence<T>>::ERASE, i });
 
 			return i;
 		}
+		//Erases count elements starting at i
+		void erase(int i, int count)
+		{
+			assert(i >= 0 && count >= 0 && (size_t)(i + count) <= m_ctnr.size());
+
+			if (count > 0) {
+				indexErased(i, count);
+				m_ctnr.erase(m_ctnr.begin() + i, m_ctnr.begin() + i + count);
+
+				this->signal(Event<Sequence<T>>{ Event<Sequence<T>>::ERASE_RANGE, i, count });
+			}
+		}
 		int find(T* obj) const
 		{
 			int result = -1;
 
 			if (obj) {
-				if (auto it = std::find(m_ctnr.begin(), m_ctnr.end(), obj); it != m_ctnr.end())
-					result = std::distance(m_ctnr.begin(), it);
+				if (auto it = m_index.find(obj); it != m_index.end()) {
+					//Positions are updated lazily, from the first one that may have shifted
+					if (it->second < 0 || (size_t)it->second >= m_ctnr.size() || m_ctnr[it->second].get() != obj) {
+						for (size_t j = m_validBelow; j < m_ctnr.size(); j++)
+							m_index[m_ctnr[j].get()] = static_cast<int>(j);
+						m_validBelow = m_ctnr.size();
+					}
+					result = it->second;
+				}
 			}
 
 			return result;
@@ -148,11 +214,33 @@ namespace nif
 		}
 		void clear()
 		{
-			while (!m_ctnr.empty())
-				erase(m_ctnr.size() - 1);
+			erase(0, size());
+		}
+
+	private:
+		void indexInserted(int i, int count)
+		{
+			for (int j = i; j < i + count; j++)
+				m_index[m_ctnr[j].get()] = j;
+
+			//Appending shifts nothing
+			if ((size_t)(i + count) != m_ctnr.size())
+				m_validBelow = std::min(m_validBelow, (size_t)i);
+			else if (m_validBelow == (size_t)i)
+				m_validBelow = m_ctnr.size();
+		}
+		void indexErased(int i, int count)
+		{
+			for (int j = i; j < i + count; j++)
+				m_index.erase(m_ctnr[j].get());
+			m_validBelow = std::min(m_validBelow, (size_t)i);
 		}
 
 	private:
 		ctnr_type m_ctnr;
+
+		//Membership, and the position of each element. Positions at or above m_validBelow may be out of date.
+		mutable std::unordered_map<T*, int> m_index;
+		mutable size_t m_validBelow{ 0 };
 	};
 }
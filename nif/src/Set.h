@@ -52,7 +52,7 @@ namespace nif
 	public:
 		virtual ~IListener() = default;
 
-		void receive(const Event<nif::Set<T>>&e, Observable<nif::Set<T>>&)
+		virtual void receive(const Event<nif::Set<T>>&e, Observable<nif::Set<T>>&)
 		{
 			switch (e.type) {
 			case Event<nif::Set<T>>::ADD:
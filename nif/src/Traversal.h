@@ -17,14 +17,80 @@
 //along with SVFX Editor. If not, see <https://www.gnu.org/licenses/>.
 
 #pragma once
+#include <array>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
 #include "nif_types.h"
 
 namespace nif
 {
+	template<typename... Ts>
+	struct type_list
+	{
+		constexpr static size_t size = sizeof...(Ts);
+	};
+
+	template<size_t I, typename List> struct type_at;
+	template<typename T, typename... Ts>
+	struct type_at<0, type_list<T, Ts...>> { using type = T; };
+	template<size_t I, typename T, typename... Ts>
+	struct type_at<I, type_list<T, Ts...>> : type_at<I - 1, type_list<Ts...>> {};
+
+	//Position of T in List, or List::size if it is not there
+	template<typename T, typename... Ts>
+	constexpr size_t indexOf(type_list<Ts...>)
+	{
+		size_t i = 0;
+		bool found = ((std::is_same_v<T, Ts> ? true : (i++, false)) || ...);
+		return found ? i : sizeof...(Ts);
+	}
+
+	//Every type that a NiTraverser can visit. Must match the traverse overloads below.
+	using traversable_types = type_list<
+		NiObject, NiObjectNET, NiAVObject, NiNode, NiBillboardNode, BSFadeNode,
+		NiProperty, NiAlphaProperty, BSShaderProperty, BSEffectShaderProperty,
+		NiBoolData, NiFloatData,
+		NiInterpolator, NiBoolInterpolator, NiFloatInterpolator,
+		NiBlendInterpolator, NiBlendBoolInterpolator, NiBlendFloatInterpolator,
+		NiTimeController, NiSingleInterpController,
+		NiParticleSystem, NiPSysData,
+		NiPSysModifier, NiPSysAgeDeathModifier, NiPSysBoundUpdateModifier, NiPSysGravityModifier,
+		NiPSysPositionModifier, NiPSysRotationModifier, BSPSysScaleModifier, BSPSysSimpleColorModifier,
+		NiPSysEmitter, NiPSysVolumeEmitter, NiPSysBoxEmitter, NiPSysCylinderEmitter, NiPSysSphereEmitter,
+		NiPSysUpdateCtlr, NiPSysModifierCtlr, NiPSysEmitterCtlr, NiPSysGravityStrengthCtlr,
+		NiExtraData, NiStringExtraData, NiStringsExtraData>;
+
+	//Dense, compile-time index of a traversable type. Types we don't know get TRAVERSABLE_COUNT.
+	constexpr size_t TRAVERSABLE_COUNT = traversable_types::size;
+	template<typename T>
+	constexpr size_t type_ordinal = indexOf<T>(traversable_types{});
+	template<size_t I>
+	using traversable_type = typename type_at<I, traversable_types>::type;
+
+	static_assert(TRAVERSABLE_COUNT <= UINT8_MAX);
+
+	//How a traverser is sent to an object by NiTraversable::dispatch.
+	enum class Dispatch
+	{
+		//Through the virtual receive and traverse
+		VIRTUAL,
+		//Through a table of functions indexed by type ordinal, if the traverser has one
+		TABLE,
+	};
+
 	class NiTraverser
 	{
+	public:
+		//Calls the traverser with an object of the type that the table index says it is
+		using DispatchFcn = void(*)(NiTraverser&, NiObject&);
+
 	public:
 		virtual ~NiTraverser() = default;
+
+		//Our dispatch table, if we have one and it is enabled
+		const DispatchFcn* dispatchTable() const { return m_dispatchTable; }
+
 		virtual void traverse(NiObject& obj) {}
 		virtual void traverse(NiObjectNET& obj) {}
 		virtual void traverse(NiAVObject& obj) {}
@@ -77,6 +143,9 @@ namespace nif
 		virtual void traverse(NiStringExtraData& obj) {}
 		virtual void traverse(NiStringsExtraData& obj) {}
 		//etc.
+
+	protected:
+		const DispatchFcn* m_dispatchTable{ nullptr };
 	};
 
 	//Inject into the inheritance chain of NiObjects. 
@@ -84,10 +153,14 @@ namespace nif
 	// (i.e. traversal of the static inheritance chain),
 	//and the virtual member function receive(NiTraverser&), used
 	//for "horizontal" traversal (i.e. traversal of the dynamic graph of NiObjects).
+	//Also records the type ordinal of the most derived type, for dispatch(NiTraverser&).
 	template<typename T, typename Base>
 	struct NiTraversable : Base
 	{
 		using base_type = Base;
+
+		NiTraversable() { this->m_ordinal = static_cast<std::uint8_t>(type_ordinal<T>); }
+
 		virtual void receive(NiTraverser& t) override
 		{
 			t.traverse(static_cast<T&>(*this));
@@ -101,6 +174,21 @@ namespace nif
 		{
 			t.traverse(static_cast<T&>(*this));
 		}
+
+		//Same as receive, but goes through the dispatch table of t if it has one.
+		//This is one indirect call instead of two virtual ones.
+		void dispatch(NiTraverser& t)
+		{
+			if (auto table = t.dispatchTable(); table && m_ordinal < TRAVERSABLE_COUNT)
+				table[m_ordinal](t, static_cast<T&>(*this));
+			else
+				receive(t);
+		}
+
+		size_t ordinal() const { return m_ordinal; }
+
+	protected:
+		std::uint8_t m_ordinal{ static_cast<std::uint8_t>(type_ordinal<T>) };
 	};
 
 	//TraverserType<T> should inherit VerticalTraverser<T, TraverserType> and 
@@ -152,12 +240,18 @@ namespace nif
 
 	//TraverserType should inherit HorizontalTraverser<TraverserType> 
 	//and implement a template function void invoke(T&)
+	//We also build a table of invoke for every traversable type, that dispatch uses by default.
+	//TraverserType should not override traverse, the table would not see it.
 	template<typename TraverserType>
 	class HorizontalTraverser : public NiTraverser
 	{
 	public:
+		HorizontalTraverser() { m_dispatchTable = s_table.data(); }
 		virtual ~HorizontalTraverser() = default;
 
+		//Choose how dispatch reaches us (the virtual traverse is always available to receive)
+		void setDispatch(Dispatch mode) { m_dispatchTable = mode == Dispatch::TABLE ? s_table.data() : nullptr; }
+
 		//implement in TraverserType
 		//template<typename T> void invoke(T&) {}
 
@@ -212,6 +306,22 @@ namespace nif
 		virtual void traverse(NiExtraData& obj) override { static_cast<TraverserType&>(*this).invoke(obj); }
 		virtual void traverse(NiStringExtraData& obj) override { static_cast<TraverserType&>(*this).invoke(obj); }
 		virtual void traverse(NiStringsExtraData& obj) override { static_cast<TraverserType&>(*this).invoke(obj); }
+
+	private:
+		template<typename T>
+		static void invokeAs(NiTraverser& t, NiObject& obj)
+		{
+			static_cast<TraverserType&>(t).invoke(static_cast<T&>(obj));
+		}
+
+		template<size_t... I>
+		constexpr static std::array<DispatchFcn, sizeof...(I)> makeTable(std::index_sequence<I...>)
+		{
+			return { &invokeAs<traversable_type<I>>... };
+		}
+
+		constexpr static std::array<DispatchFcn, TRAVERSABLE_COUNT> s_table =
+			makeTable(std::make_index_sequence<TRAVERSABLE_COUNT>{});
 	};
 	
 	//A variant that calls a separate function object instead of a member function.
@@ -17,6 +17,7 @@
 //along with SVFX Editor. If not, see <https://www.gnu.org/licenses/>.
 
 #pragma once
+#include <algorithm>
 #include <cassert>
 #include "Observable.h"
 
@@ -31,9 +32,12 @@ namespace nif
 			INSERT,
 			ERASE,
 			MOVE,
+			INSERT_RANGE,
+			ERASE_RANGE,
 		} type{ INSERT };
 		int pos1{ -1 };
 		int pos2{ -1 };
+		int count{ 1 };//number of elements, for ranges
 	};
 
 	template<typename T>
@@ -42,7 +46,7 @@ namespace nif
 	public:
 		virtual ~IListener() = default;
 
-		void receive(const Event<nif::Vector<T>>&e, Observable<nif::Vector<T>>&)
+		virtual void receive(const Event<nif::Vector<T>>&e, Observable<nif::Vector<T>>&)
 		{
 			switch (e.type) {
 			case Event<nif::Vector<T>>::INSERT:
@@ -54,6 +58,12 @@ namespace nif
 			case Event<nif::Vector<T>>::MOVE:
 				onMove(e.pos1, e.pos2);
 				break;
+			case Event<nif::Vector<T>>::INSERT_RANGE:
+				onInsertRange(e.pos1, e.count);
+				break;
+			case Event<nif::Vector<T>>::ERASE_RANGE:
+				onEraseRange(e.pos1, e.count);
+				break;
 			}
 		}
 
@@ -61,6 +71,18 @@ namespace nif
 		virtual void onInsert(int) {}
 		virtual void onErase(int) {}
 		virtual void onMove(int from, int to) {}
+
+		//count elements were inserted/erased starting at pos. Override to handle them in one go.
+		virtual void onInsertRange(int pos, int count)
+		{
+			for (int i = 0; i < count; i++)
+				onInsert(pos + i);
+		}
+		virtual void onEraseRange(int pos, int count)
+		{
+			for (int i = count - 1; i >= 0; i--)
+				onErase(pos + i);
+		}
 	};
 	template<typename T> using VectorListener = IListener<Vector<T>>;
 
@@ -112,6 +134,19 @@ namespace nif
 
 			this->signal(Event<Vector<T>>{ Event<Vector<T>>::INSERT, i });
 		}
+		//Inserts count default elements before i
+		void insert(int i, int count)
+		{
+			assert(i >= 0 && (size_t)i <= m_ctnr.size() && count >= 0);
+
+			if (count > 0) {
+				//Elements can't be copied, so append and rotate them into place
+				m_ctnr.resize(m_ctnr.size() + count);
+				std::rotate(m_ctnr.begin() + i, m_ctnr.end() - count, m_ctnr.end());
+
+				this->signal(Event<Vector<T>>{ Event<Vector<T>>::INSERT_RANGE, i, -1, count });
+			}
+		}
 		void erase(int i)
 		{
 			assert(i >= 0 && (size_t)i < m_ctnr.size());
@@ -120,6 +155,17 @@ namespace nif
 
 			this->signal(Event<Vector<T>>{ Event<Vector<T>>::ERASE, i });
 		}
+		//Erases count elements starting at i
+		void erase(int i, int count)
+		{
+			assert(i >= 0 && count >= 0 && (size_t)(i + count) <= m_ctnr.size());
+
+			if (count > 0) {
+				m_ctnr.erase(m_ctnr.begin() + i, m_ctnr.begin() + i + count);
+
+				this->signal(Event<Vector<T>>{ Event<Vector<T>>::ERASE_RANGE, i, -1, count });
+			}
+		}
 		void move(int from, int to)
 		{
 			assert(from >= 0 && (size_t)from < m_ctnr.size());
@@ -166,10 +212,11 @@ namespace nif
 		void resize(int size)
 		{
 			assert(size >= 0);
-			while (m_ctnr.size() > (size_t)size)
-				pop_back();
-			while (m_ctnr.size() < (size_t)size)
-				push_back();
+			int current = static_cast<int>(m_ctnr.size());
+			if (current > size)
+				erase(size, current - size);
+			else
+				insert(current, size - current);
 		}
 
 		size_t size() const
@@ -179,8 +226,7 @@ namespace nif
 
 		void clear()
 		{
-			while (!m_ctnr.empty())
-				pop_back();
+			erase(0, static_cast<int>(m_ctnr.size()));
 		}
 
 		friend constexpr bool operator==(const Vector<T>& lhs, const Vector<T>& rhs)
@@ -3,3 +3,5 @@
 #include "nif_data.h"
 #include "nif_objects.h"
 #include "File.h"
+#include "Loader.h"
+#include "Probe.h"
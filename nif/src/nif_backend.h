@@ -57,4 +57,12 @@
 #include "obj/BSEffectShaderProperty.h"
 #include "obj/NiAlphaProperty.h"
 
-#include "obj/NiControllerManager.h"
\ No newline at end of file
+#include "obj/NiControllerManager.h"
+
+namespace nif
+{
+	//Niflib registers its object types on the first call to ReadNifList, through an unguarded global
+	//flag, so two first reads on different threads race. This makes that first read once, alone.
+	//Call it before reading on more than one thread.
+	void initNiflib();
+}
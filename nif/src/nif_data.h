@@ -19,6 +19,7 @@
 #pragma once
 #include "Assignable.h"
 #include "FlagSet.h"
+#include "KeyTable.h"
 #include "List.h"
 #include "Property.h"
 #include "Sequence.h"
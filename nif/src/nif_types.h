@@ -141,6 +141,7 @@ namespace nif
 namespace Niflib
 {
 	template<typename T> class Ref;
+	class Type;
 
 	class NiObject;
 	class NiObjectNET;
@@ -54,14 +54,14 @@ namespace node
 			for (auto&& data : obj.extraData) {
 				assert(data);
 				ctor.pushObject(data);
-				data->receive(ctor);
+				data->dispatch(ctor);
 				ctor.popObject();
 			}
 
 			for (auto&& ctlr : obj.controllers) {
 				assert(ctlr);
 				ctor.pushObject(ctlr);
-				ctlr->receive(ctor);
+				ctlr->dispatch(ctor);
 				ctor.popObject();
 			}
 
@@ -34,28 +34,22 @@ static_assert(TO_PIXEL == static_cast<decltype(TO_PIXEL)>(&std::floor));
 
 class EraseOp final : public gui::ICommand
 {
-	const ni_ptr<Vector<Key<float>>> m_target;
+	const ni_ptr<KeyTable<float>> m_target;
 	std::vector<int> m_keys;
-	std::vector<Key<float>> m_storage;
+	std::vector<KeyTable<float>::Row> m_storage;
 
 public:
-	EraseOp(ni_ptr<Vector<Key<float>>>&& target, std::vector<int>&& keys) :
+	EraseOp(ni_ptr<KeyTable<float>>&& target, std::vector<int>&& keys) :
 		m_target{ std::move(target) }, m_keys{ std::move(keys) }
 	{
 		assert(m_target);
 
 		std::sort(m_keys.begin(), m_keys.end());
 
-		m_storage.resize(m_keys.size());
-		for (size_t i = 0; i < m_keys.size(); i++) {
-			assert(m_keys[i] >= 0 && (size_t)m_keys[i] < m_target->size());
-			m_storage[i].time.set(m_target->at(m_keys[i]).time.get());
-			m_storage[i].value.set(m_target->at(m_keys[i]).value.get());
-			m_storage[i].fwdTan.set(m_target->at(m_keys[i]).fwdTan.get());
-			m_storage[i].bwdTan.set(m_target->at(m_keys[i]).bwdTan.get());
-			m_storage[i].tension.set(m_target->at(m_keys[i]).tension.get());
-			m_storage[i].bias.set(m_target->at(m_keys[i]).bias.get());
-			m_storage[i].continuity.set(m_target->at(m_keys[i]).continuity.get());
+		m_storage.reserve(m_keys.size());
+		for (int i : m_keys) {
+			assert(i >= 0 && (size_t)i < m_target->size());
+			m_storage.push_back(m_target->row(i));
 		}
 	}
 
@@ -69,16 +63,8 @@ public:
 	virtual void reverse() override
 	{
 		//insert front to back
-		for (size_t i = 0; i < m_keys.size(); i++) {
-			m_target->insert(m_keys[i]);
-			m_target->at(m_keys[i]).time.set(m_storage[i].time.get());
-			m_target->at(m_keys[i]).value.set(m_storage[i].value.get());
-			m_target->at(m_keys[i]).fwdTan.set(m_storage[i].fwdTan.get());
-			m_target->at(m_keys[i]).bwdTan.set(m_storage[i].bwdTan.get());
-			m_target->at(m_keys[i]).tension.set(m_storage[i].tension.get());
-			m_target->at(m_keys[i]).bias.set(m_storage[i].bias.get());
-			m_target->at(m_keys[i]).continuity.set(m_storage[i].continuity.get());
-		}
+		for (size_t i = 0; i < m_keys.size(); i++)
+			m_target->insert(m_keys[i], m_storage[i]);
 	}
 	virtual bool reversible() const override
 	{
@@ -88,12 +74,12 @@ public:
 
 class InsertOp final : public gui::ICommand
 {
-	const ni_ptr<Vector<Key<float>>> m_target;
+	const ni_ptr<KeyTable<float>> m_target;
 	const int m_index;
 	const gui::Floats<2> m_position;
 
 public:
-	InsertOp(ni_ptr<Vector<Key<float>>>&& target, int index, const gui::Floats<2>& pos) :
+	InsertOp(ni_ptr<KeyTable<float>>&& target, int index, const gui::Floats<2>& pos) :
 		m_target{ std::move(target) }, m_index{ index }, m_position{ pos }
 	{
 		assert(m_target);
@@ -101,9 +87,7 @@ public:
 
 	virtual void execute() override
 	{
-		m_target->insert(m_index);
-		m_target->at(m_index).time.set(m_position[0]);
-		m_target->at(m_index).value.set(m_position[1]);
+		m_target->insert(m_index, KeyTable<float>::Row{ m_position[0], m_position[1] });
 	}
 	virtual void reverse() override
 	{
@@ -117,7 +101,7 @@ public:
 
 class CentreMoveOp final : public node::AnimationCurve::MoveOperation
 {
-	const ni_ptr<Vector<Key<float>>> m_target;
+	const ni_ptr<KeyTable<float>> m_target;
 
 	std::vector<int> m_initI;
 	std::vector<gui::Floats<2>> m_initPos;
@@ -133,7 +117,7 @@ class CentreMoveOp final : public node::AnimationCurve::MoveOperation
 	bool m_dirty{ false };
 
 public:
-	CentreMoveOp(const ni_ptr<Vector<Key<float>>>& target, std::vector<int>&& indices, const gui::Floats<2>& init_pos) :
+	CentreMoveOp(const ni_ptr<KeyTable<float>>& target, std::vector<int>&& indices, const gui::Floats<2>& init_pos) :
 		m_target{ target }, m_initI{ std::move(indices) }, m_start{ init_pos }
 	{
 		assert(target);
@@ -143,7 +127,7 @@ public:
 
 		m_initPos.reserve(m_initI.size());
 		for (int i : m_initI) {
-			m_initPos.push_back({ target->at(i).time.get(), target->at(i).value.get() });
+			m_initPos.push_back({ target->get<KeyColumn::TIME>(i), target->get<KeyColumn::VALUE>(i) });
 		}
 		m_currentI = m_initI;
 		m_currentPos = m_initPos;
@@ -183,8 +167,8 @@ public:
 			}
 
 			for (size_t i = 0; i < m_currentI.size(); i++) {
-				m_target->at(m_currentI[i]).time.set(m_currentPos[i][0]);
-				m_target->at(m_currentI[i]).value.set(m_currentPos[i][1]);
+				m_target->set<KeyColumn::TIME>(m_currentI[i], m_currentPos[i][0]);
+				m_target->set<KeyColumn::VALUE>(m_currentI[i], m_currentPos[i][1]);
 			}
 
 			m_dirty = false;
@@ -193,8 +177,8 @@ public:
 	virtual void reverse() override
 	{
 		for (size_t i = 0; i < m_currentI.size(); i++) {
-			m_target->at(m_currentI[i]).time.set(m_initPos[i][0]);
-			m_target->at(m_currentI[i]).value.set(m_initPos[i][1]);
+			m_target->set<KeyColumn::TIME>(m_currentI[i], m_initPos[i][0]);
+			m_target->set<KeyColumn::VALUE>(m_currentI[i], m_initPos[i][1]);
 		}
 
 		if (m_move[0] < 0.0f) {
@@ -236,7 +220,7 @@ public:
 						if (i < (int)m_finalI.size() - 1 && m_finalI[i] + 1 == m_finalI[i + 1])
 							break;
 						//is the next key at a greater or equal time to ours?
-						else if (m_target->at(m_finalI[i] + 1).time.get() >= m_currentPos[i][0])
+						else if (m_target->get<KeyColumn::TIME>(m_finalI[i] + 1) >= m_currentPos[i][0])
 							break;
 						//else we should be moved up (at least) one step
 					}
@@ -253,7 +237,7 @@ public:
 						if (i > 0 && m_finalI[i] - 1 == m_finalI[i - 1])
 							break;
 						//is the next key at a greater or equal time to ours?
-						else if (m_target->at(m_finalI[i] - 1).time.get() <= m_currentPos[i][0])
+						else if (m_target->get<KeyColumn::TIME>(m_finalI[i] - 1) <= m_currentPos[i][0])
 							break;
 						//else we should be moved down (at least) one step
 					}
@@ -268,7 +252,7 @@ public:
 
 class FwdMoveOp final : public node::AnimationCurve::MoveOperation
 {
-	const ni_ptr<Vector<Key<float>>> m_target;
+	const ni_ptr<KeyTable<float>> m_target;
 	const int m_index;
 
 	float m_init;
@@ -278,27 +262,27 @@ class FwdMoveOp final : public node::AnimationCurve::MoveOperation
 	const bool m_align;
 
 public:
-	FwdMoveOp(const ni_ptr<Vector<Key<float>>>& target, int index, bool align = false) :
+	FwdMoveOp(const ni_ptr<KeyTable<float>>& target, int index, bool align = false) :
 		m_target{ target }, m_index{ index }, m_align{ align }
 	{
 		assert(m_target && m_index >= 0 && (size_t)m_index < m_target->size());
-		m_init = target->at(m_index).fwdTan.get();
+		m_init = target->get<KeyColumn::FWD_TAN>(m_index);
 		m_current = m_init;
 		if (m_align)
-			m_bwdInit = target->at(m_index).bwdTan.get();
+			m_bwdInit = target->get<KeyColumn::BWD_TAN>(m_index);
 	}
 
 	virtual void execute() override
 	{
-		m_target->at(m_index).fwdTan.set(m_current);
+		m_target->set<KeyColumn::FWD_TAN>(m_index, m_current);
 		if (m_align)
-			m_target->at(m_index).bwdTan.set(m_current);
+			m_target->set<KeyColumn::BWD_TAN>(m_index, m_current);
 	}
 	virtual void reverse() override
 	{
-		m_target->at(m_index).fwdTan.set(m_init);
+		m_target->set<KeyColumn::FWD_TAN>(m_index, m_init);
 		if (m_align)
-			m_target->at(m_index).bwdTan.set(m_bwdInit);
+			m_target->set<KeyColumn::BWD_TAN>(m_index, m_bwdInit);
 	}
 	virtual bool reversible() const override
 	{
@@ -307,8 +291,8 @@ public:
 
 	virtual void update(const gui::Floats<2>& local_pos) override
 	{
-		float dv = local_pos[1] - m_target->at(m_index).value.get();
-		float dt = local_pos[0] - m_target->at(m_index).time.get();
+		float dv = local_pos[1] - m_target->get<KeyColumn::VALUE>(m_index);
+		float dt = local_pos[0] - m_target->get<KeyColumn::TIME>(m_index);
 		m_current = dt > 0.0f ? dv / dt : std::copysign(1000.0f, dv);
 
 		execute();
@@ -317,7 +301,7 @@ public:
 
 class BwdMoveOp final : public node::AnimationCurve::MoveOperation
 {
-	const ni_ptr<Vector<Key<float>>> m_target;
+	const ni_ptr<KeyTable<float>> m_target;
 	const int m_index;
 
 	float m_init;
@@ -327,27 +311,27 @@ class BwdMoveOp final : public node::AnimationCurve::MoveOperation
 	const bool m_align;
 
 public:
-	BwdMoveOp(const ni_ptr<Vector<Key<float>>>& target, int index, bool align = false) :
+	BwdMoveOp(const ni_ptr<KeyTable<float>>& target, int index, bool align = false) :
 		m_target{ target }, m_index{ index }, m_align{ align }
 	{
 		assert(m_target&& m_index >= 0 && (size_t)m_index < m_target->size());
-		m_init = target->at(m_index).bwdTan.get();
+		m_init = target->get<KeyColumn::BWD_TAN>(m_index);
 		m_current = m_init;
 		if (m_align)
-			m_fwdInit = target->at(m_index).fwdTan.get();
+			m_fwdInit = target->get<KeyColumn::FWD_TAN>(m_index);
 	}
 
 	virtual void execute() override
 	{
-		m_target->at(m_index).bwdTan.set(m_current);
+		m_target->set<KeyColumn::BWD_TAN>(m_index, m_current);
 		if (m_align)
-			m_target->at(m_index).fwdTan.set(m_current);
+			m_target->set<KeyColumn::FWD_TAN>(m_index, m_current);
 	}
 	virtual void reverse() override
 	{
-		m_target->at(m_index).bwdTan.set(m_init);
+		m_target->set<KeyColumn::BWD_TAN>(m_index, m_init);
 		if (m_align)
-			m_target->at(m_index).fwdTan.set(m_fwdInit);
+			m_target->set<KeyColumn::FWD_TAN>(m_index, m_fwdInit);
 	}
 	virtual bool reversible() const override
 	{
@@ -356,8 +340,8 @@ public:
 
 	virtual void update(const gui::Floats<2>& local_pos) override
 	{
-		float dv = local_pos[1] - m_target->at(m_index).value.get();
-		float dt = local_pos[0] - m_target->at(m_index).time.get();
+		float dv = local_pos[1] - m_target->get<KeyColumn::VALUE>(m_index);
+		float dt = local_pos[0] - m_target->get<KeyColumn::TIME>(m_index);
 		m_current = dt < 0.0f ? dv / dt : std::copysign(1000.0f, -dv);
 
 		execute();
@@ -374,9 +358,8 @@ node::AnimationCurve::AnimationCurve(const ni_ptr<NiTimeController>& ctlr, const
 	m_ctlr->startTime.addListener(*this);
 	m_ctlr->stopTime.addListener(*this);
 
-	int i = 0;
-	for (auto&& key : m_data->keys)
-		newChild<AnimationKey>(*this, i++);
+	for (int i = 0; (size_t)i < m_data->keys.size(); i++)
+		newChild<AnimationKey>(*this, i);
 }
 
 node::AnimationCurve::~AnimationCurve()
@@ -394,6 +377,8 @@ void node::AnimationCurve::frame(gui::FrameDrawer& fd)
 {
 	assert(m_data && m_ctlr);
 
+	refreshIndices();
+
 	//We can optimise later, just get this working first.
 	//Later we might want to cache these values.
 	//We should also do clip checking in y.
@@ -507,7 +492,7 @@ void node::AnimationCurve::frame(gui::FrameDrawer& fd)
 
 			//If the last key is exactly at the stop time (common), it will not get evaluated.
 			//We do this just to clean it (preventing it from triggering a recalulation).
-			if (keys().size() > 0 && keys().back().time.get() == stopTime)
+			if (keys().size() > 0 && keys().times().back() == stopTime)
 				animationKey(keys().size() - 1).eval(0.0f);
 		}
 
@@ -538,41 +523,62 @@ void node::AnimationCurve::frame(gui::FrameDrawer& fd)
 	Composite::frame(fd);
 }
 
-void node::AnimationCurve::onInsert(int pos)
+void node::AnimationCurve::onInsert(int pos, int count)
 {
 	assert(pos >= 0 && size_t(pos) <= getChildren().size());
 
-	//Insert handle at pos
-	insertChild(pos, std::make_unique<AnimationKey>(*this, pos));
+	//Insert handles at [pos, pos + count)
+	for (int i = pos; i < pos + count; i++)
+		insertChild(i, std::make_unique<AnimationKey>(*this, i));
 
-	//Handles after pos must update their index
-	for (int i = pos + 1; (size_t)i < getChildren().size(); i++)
-		static_cast<AnimationKey*>(getChildren()[i].get())->setIndex(i);
+	//Handles after them must update their index
+	markStale(pos + count);
 
 	//The handle right before pos must refresh its interpolation
 	if (pos != 0)
 		static_cast<AnimationKey*>(getChildren()[pos - 1].get())->setDirty();
 }
 
-void node::AnimationCurve::onErase(int pos)
+void node::AnimationCurve::onErase(int pos, int count)
 {
-	assert(pos >= 0 && size_t(pos) < getChildren().size());
+	assert(pos >= 0 && size_t(pos + count) <= getChildren().size());
 
-	//The handle at i = pos is invalidated
-	static_cast<AnimationKey*>(getChildren()[pos].get())->invalidate();
+	for (int i = pos + count - 1; i >= pos; i--)
+		eraseChild(i);
 
-	//Erase invalidated handle
-	eraseChild(pos);
-
-	//Handles at i > pos must update their index
-	for (int i = pos; (size_t)i < getChildren().size(); i++)
-		static_cast<AnimationKey*>(getChildren()[i].get())->setIndex(i);
+	//Handles at i >= pos must update their index
+	markStale(pos);
 
 	//The handle at i = pos - 1 must refresh
 	if (pos != 0)
 		static_cast<AnimationKey*>(getChildren()[pos - 1].get())->setDirty();
 }
 
+void node::AnimationCurve::onSet(KeyColumn column, int pos, int count)
+{
+	//Our keys don't listen to the table themselves, we pass the change on to the ones affected
+	assert(pos >= 0 && size_t(pos + count) <= getChildren().size());
+
+	for (int i = pos; i < pos + count; i++) {
+		switch (column) {
+		case KeyColumn::TIME:
+		case KeyColumn::VALUE:
+			animationKey(i).onPositionSet();
+			break;
+		case KeyColumn::FWD_TAN:
+			animationKey(i).setDirty();
+			break;
+		case KeyColumn::BWD_TAN:
+			if (i != 0)
+				animationKey(i - 1).setDirty();
+			break;
+		default:
+			//not drawn
+			break;
+		}
+	}
+}
+
 void node::AnimationCurve::onMove(int from, int to)
 {
 	moveChild(from, to);
@@ -590,8 +596,7 @@ void node::AnimationCurve::onMove(int from, int to)
 		high = to;
 	}
 
-	for (int i = low; i < high + 1; i++)
-		static_cast<AnimationKey*>(getChildren()[i].get())->setIndex(i);
+	markStale(low);
 
 	//The handle before min(from, to) must refresh
 	if (low != 0)
@@ -600,6 +605,21 @@ void node::AnimationCurve::onMove(int from, int to)
 	static_cast<AnimationKey*>(getChildren()[high].get())->setDirty();
 }
 
+void node::AnimationCurve::refreshIndices()
+{
+	if (m_firstStale >= 0) {
+		for (int i = m_firstStale; (size_t)i < getChildren().size(); i++)
+			static_cast<AnimationKey*>(getChildren()[i].get())->setIndex(i);
+		m_firstStale = -1;
+	}
+}
+
+void node::AnimationCurve::markStale(int i)
+{
+	if (m_firstStale < 0 || i < m_firstStale)
+		m_firstStale = i;
+}
+
 void node::AnimationCurve::onSet(const float&)
 {
 	m_clipDirty = true;
@@ -646,7 +666,7 @@ node::AnimationKey& node::AnimationCurve::animationKey(int i) const
 	return *static_cast<AnimationKey*>(getChildren()[i].get());
 }
 
-ni_ptr<Vector<Key<float>>> node::AnimationCurve::getKeysPtr() const
+ni_ptr<KeyTable<float>> node::AnimationCurve::getKeysPtr() const
 {
 	return make_ni_ptr(m_data, &NiFloatData::keys);
 }
@@ -659,11 +679,11 @@ ni_ptr<Property<KeyType>> node::AnimationCurve::getTypePtr() const
 gui::Floats<2> node::AnimationCurve::getBounds() const
 {
 	gui::Floats<2> result = { 0.0f, 0.0f };
-	for (auto&& key : m_data->keys) {
-		if (float val = key.value.get(); val < result[0])
-			result[0] = key.value.get();
+	for (float val : m_data->keys.values()) {
+		if (val < result[0])
+			result[0] = val;
 		else if (val > result[1])
-			result[1] = key.value.get();
+			result[1] = val;
 	}
 	return result;
 }
@@ -672,7 +692,7 @@ std::unique_ptr<gui::ICommand> node::AnimationCurve::getInsertOp(const gui::Floa
 {
 	//Locate the first key with larger time and insert before it.
 	int index = 0;
-	for (; index < (int)m_data->keys.size() && m_data->keys.at(index).time.get() < pos[0]; index++) {}
+	for (; index < (int)m_data->keys.size() && m_data->keys.get<KeyColumn::TIME>(index) < pos[0]; index++) {}
 
 	return std::make_unique<InsertOp>(make_ni_ptr(m_data, &NiFloatData::keys), index, pos);
 }
@@ -708,22 +728,22 @@ void node::AnimationCurve::buildClip(const gui::Floats<2>& lims, const gui::Floa
 	}
 	else {
 		//if the first key is greater than tStart, special treatment is required
-		if (float t = m_data->keys.front().time.get(); t > tStart)
+		if (float t = m_data->keys.times().front(); t > tStart)
 			m_segments.push_back({ -1, tStart, std::min(t, tStop), 0.0f, 0.0f });
 
 		//if the first key is greater than tStop, we're done
 		int i = 0;
-		if (m_data->keys.at(i).time.get() < tStop) {
+		if (m_data->keys.get<KeyColumn::TIME>(i) < tStop) {
 
 			//Now proceed until the next key is greater than tStart, or we reach the last key.
 			//This is the first relevant key.
-			for (; i < (int)m_data->keys.size() - 1 && m_data->keys.at(i + 1).time.get() <= tStart; i++) {}
+			for (; i < (int)m_data->keys.size() - 1 && m_data->keys.get<KeyColumn::TIME>(i + 1) <= tStart; i++) {}
 
 			//keys.at(i) is less than tStop
 
 			for (; i < (int)m_data->keys.size(); i++) {
 
-				float t = m_data->keys.at(i).time.get();
+				float t = m_data->keys.get<KeyColumn::TIME>(i);
 
 				//Determine limits (might need interpolation)
 				float tBegin;
@@ -731,7 +751,7 @@ void node::AnimationCurve::buildClip(const gui::Floats<2>& lims, const gui::Floa
 				if (t < tStart) {
 					tBegin = tStart;
 					if (i < (int)m_data->keys.size() - 1)
-						tauBegin = (tStart - t) / (m_data->keys.at(i + 1).time.get() - t);
+						tauBegin = (tStart - t) / (m_data->keys.get<KeyColumn::TIME>(i + 1) - t);
 					else
 						tauBegin = 0.0f;
 				}
@@ -746,12 +766,12 @@ void node::AnimationCurve::buildClip(const gui::Floats<2>& lims, const gui::Floa
 					tEnd = tStop;
 					tauEnd = 1.0f;
 				}
-				else if (m_data->keys.at(i + 1).time.get() > tStop) {
+				else if (m_data->keys.get<KeyColumn::TIME>(i + 1) > tStop) {
 					tEnd = tStop;
-					tauEnd = (tStop - t) / (m_data->keys.at(i + 1).time.get() - t);
+					tauEnd = (tStop - t) / (m_data->keys.get<KeyColumn::TIME>(i + 1) - t);
 				}
 				else {
-					tEnd = m_data->keys.at(i + 1).time.get();
+					tEnd = m_data->keys.get<KeyColumn::TIME>(i + 1);
 					tauEnd = 1.0f;
 				}
 
@@ -767,7 +787,7 @@ void node::AnimationCurve::buildClip(const gui::Floats<2>& lims, const gui::Floa
 					for (int n = 0; n < 3; n++) {
 						if (n == 2 || (!std::isnan(tauHigh[n]) && tauHigh[n] > tauLow && tauHigh[n] < tauEnd)) {
 
-							float tHigh = t + tauHigh[n] * (m_data->keys.at(i + 1).time.get() - t);
+							float tHigh = t + tauHigh[n] * (m_data->keys.get<KeyColumn::TIME>(i + 1) - t);
 							m_segments.push_back({ i, tLow, tHigh, tauLow, tauHigh[n] });
 
 							tauLow = tauHigh[n];
@@ -869,12 +889,10 @@ node::AnimationKey::AnimationKey(AnimationCurve& curve, int index) :
 	m_curve{ &curve },
 	m_index{ index }
 {
-	if (key().fwdTan.get() != key().bwdTan.get())
+	if (get<KeyColumn::FWD_TAN>() != get<KeyColumn::BWD_TAN>())
 		m_handleType = HandleType::FREE;
 
-	key().time.addListener(*this);
-	key().value.addListener(*this);
-	m_translation = { key().time.get(), key().value.get() };
+	m_translation = { get<KeyColumn::TIME>(), get<KeyColumn::VALUE>() };
 
 	newChild<CentreHandle>(*this);
 
@@ -888,28 +906,22 @@ node::AnimationKey::~AnimationKey()
 
 	//Children need to unregister while we are still alive
 	clearChildren();
-
-	//We should have been invalidated if our key has been erased.
-	if (!m_invalid) {
-		key().time.removeListener(*this);
-		key().value.removeListener(*this);
-	}
 }
 
 void node::AnimationKey::setTranslation(const gui::Floats<2>& t)
 {
 	//is anyone actually calling this?
-	key().time.set(t[0]);
-	key().value.set(t[1]);
+	m_curve->keys().set<KeyColumn::TIME>(getIndex(), t[0]);
+	m_curve->keys().set<KeyColumn::VALUE>(getIndex(), t[1]);
 }
 
-void node::AnimationKey::onSet(const float&)
+void node::AnimationKey::onPositionSet()
 {
-	//We're listening to time and value. Don't care which one was set.
-	m_translation = { key().time.get(), key().value.get() };
+	//Don't care if it was time or value
+	m_translation = { get<KeyColumn::TIME>(), get<KeyColumn::VALUE>() };
 	setDirty();
-	if (m_index != 0)
-		m_curve->animationKey(m_index - 1).setDirty();
+	if (getIndex() != 0)
+		m_curve->animationKey(getIndex() - 1).setDirty();
 }
 
 void node::AnimationKey::onSet(const KeyType& val)
@@ -960,18 +972,18 @@ float node::AnimationKey::eval(float t)
 		m_dirty = false;
 		if (type == KEY_LINEAR) {
 			if (t <= 0.0f) {
-				return key().value.get();
+				return get<KeyColumn::VALUE>();
 			}
 			else if (t >= 1.0f) {
-				return m_index < (int)m_curve->keys().size() - 1 ? m_curve->keys().at(m_index + 1).value.get() : key().value.get();
+				return getIndex() < (int)m_curve->keys().size() - 1 ? m_curve->keys().get<KeyColumn::VALUE>(getIndex() + 1) : get<KeyColumn::VALUE>();
 			}
 			else {
-				float v0 = key().value.get();
-				return m_index < (int)m_curve->keys().size() - 1 ? v0 + t * (m_curve->keys().at(m_index + 1).value.get() - v0) : v0;
+				float v0 = get<KeyColumn::VALUE>();
+				return getIndex() < (int)m_curve->keys().size() - 1 ? v0 + t * (m_curve->keys().get<KeyColumn::VALUE>(getIndex() + 1) - v0) : v0;
 			}
 		}
 		else
-			return key().value.get();
+			return get<KeyColumn::VALUE>();
 	}
 }
 
@@ -998,14 +1010,14 @@ gui::Floats<2> node::AnimationKey::getExtrema()
 
 void node::AnimationKey::recalculate()
 {
-	m_pLo[0] = key().value.get();
+	m_pLo[0] = get<KeyColumn::VALUE>();
 
-	if (m_index < (int)m_curve->keys().size() - 1) {
-		float h = m_curve->keys().at(m_index + 1).time.get() - key().time.get();
-		float y1 = m_curve->keys().at(m_index + 1).value.get();
-		float yp1 = m_curve->keys().at(m_index + 1).bwdTan.get() * h;
+	if (getIndex() < (int)m_curve->keys().size() - 1) {
+		float h = m_curve->keys().get<KeyColumn::TIME>(getIndex() + 1) - get<KeyColumn::TIME>();
+		float y1 = m_curve->keys().get<KeyColumn::VALUE>(getIndex() + 1);
+		float yp1 = m_curve->keys().get<KeyColumn::BWD_TAN>(getIndex() + 1) * h;
 
-		m_pLo[1] = key().fwdTan.get() * h;
+		m_pLo[1] = get<KeyColumn::FWD_TAN>() * h;
 
 		m_pHi[1] = 4 * (y1 - m_pLo[0]) - m_pLo[1] - 2 * yp1;
 		m_pHi[2] = 0.5f * (yp1 - m_pHi[1]);
@@ -1026,76 +1038,76 @@ void node::AnimationKey::recalculate()
 
 
 //This will be sent to the command queue, and can safely be accessed after the widget is destroyed
+template<KeyColumn C>
 struct KeyProperty
 {
-	const ni_ptr<Vector<Key<float>>> keys;
+	const ni_ptr<KeyTable<float>> keys;
 	int index;
-	Property<float> Key<float>::* member;
 };
 
-template<>
-struct util::property_traits<KeyProperty>
+template<KeyColumn C>
+struct util::property_traits<KeyProperty<C>>
 {
-	using property_type = KeyProperty;
+	using property_type = KeyProperty<C>;
 	using value_type = float;
 	using get_type = float;
 
 	static float get(property_type p)
 	{
-		return (p.keys->at(p.index).*p.member).get();
+		return p.keys->template get<C>(p.index);
 	}
 	static void set(property_type p, float val)
 	{
-		(p.keys->at(p.index).*p.member).set(val);
+		p.keys->template set<C>(p.index, val);
 	}
 };
 
 
 //Input widgets need to follow order changes, so it fetches the key from the parent component
+template<KeyColumn C>
 struct KeyInputProperty
 {
 	node::KeyWidget* widget;
-	Property<float> Key<float>::* member;
 };
 
-template<>
-struct util::property_traits<KeyInputProperty>
+template<KeyColumn C>
+struct util::property_traits<KeyInputProperty<C>>
 {
-	using property_type = KeyInputProperty;
+	using property_type = KeyInputProperty<C>;
 	using value_type = float;
 	using get_type = float;
 
 	static float get(property_type p)
 	{
-		return (p.widget->key().*p.member).get();
+		return p.widget->template get<C>();
 	}
 	static void set(property_type p, float val)
 	{
-		(p.widget->key().*p.member).set(val);
+		p.widget->template set<C>(val);
 	}
 };
 
-template<>
-struct gui::DefaultEventSink<KeyInputProperty>
+template<KeyColumn C>
+struct gui::DefaultEventSink<KeyInputProperty<C>>
 {
 	using value_type = float;
 
-	void begin(const KeyInputProperty& p, IComponent*)
+	void begin(const KeyInputProperty<C>& p, IComponent*)
 	{
-		m_init = util::property_traits<KeyInputProperty>::get(p);
+		m_init = util::property_traits<KeyInputProperty<C>>::get(p);
 	}
-	void update(KeyInputProperty& p, IComponent*, const value_type& val)
+	void update(KeyInputProperty<C>& p, IComponent*, const value_type& val)
 	{
 		//updates will use whatever key the parent component is currently pointing at
-		util::property_traits<KeyInputProperty>::set(p, val);
+		util::property_traits<KeyInputProperty<C>>::set(p, val);
 	}
-	void end(KeyInputProperty& p, IComponent* source)
+	void end(KeyInputProperty<C>& p, IComponent* source)
 	{
 		//Lock us to a specific key before queueing
 		if (IInvoker* inv = source->getInvoker())
-			inv->queue(std::make_unique<DefaultSetCommand<KeyProperty>>(
-				KeyProperty{ p.widget->getKeysPtr(), p.widget->getIndex(), p.member },
-				util::property_traits<KeyInputProperty>::get(p),
+			inv->queue(std::make_unique<DefaultSetCommand<KeyProperty<C>>>(
+				KeyProperty<C>{ p.widget->getKeysPtr(), p.widget->getIndex() },
+				util::property_traits<KeyInputProperty<C>>::get(p),
 				m_init));
 	}
 
@@ -1117,11 +1129,11 @@ struct util::property_traits<KeyTimeProperty>
 
 	static float get(property_type p)
 	{
-		return p.widget->key().time.get();
+		return p.widget->get<KeyColumn::TIME>();
 	}
 	static void set(property_type p, float val)
 	{
-		p.widget->key().time.set(val);
+		p.widget->set<KeyColumn::TIME>(val);
 	}
 };
 
@@ -1132,17 +1144,17 @@ struct gui::DefaultEventSink<KeyTimeProperty>
 
 	void begin(const KeyTimeProperty& p, IComponent*)
 	{
-		m_init = p.widget->key().time.get();
+		m_init = p.widget->get<KeyColumn::TIME>();
 		m_op = std::make_unique<CentreMoveOp>(
 			p.widget->getKeysPtr(), 
 			std::vector<int>{ p.widget->getIndex(), },
-			gui::Floats<2>{ m_init, p.widget->key().value.get() });
+			gui::Floats<2>{ m_init, p.widget->get<KeyColumn::VALUE>() });
 	}
 	void update(KeyTimeProperty& p, IComponent*, const value_type& val)
 	{
 		//here we let the move operation itself keep track of the key
 		if (m_op)
-			m_op->update({ val, p.widget->key().value.get() });
+			m_op->update({ val, p.widget->get<KeyColumn::VALUE>() });
 	}
 	void end(KeyTimeProperty&, IComponent* source)
 	{
@@ -1169,11 +1181,11 @@ struct util::property_traits<KeyFwdTanProperty>
 
 	static float get(property_type p)
 	{
-		return p.widget->key().fwdTan.get();
+		return p.widget->get<KeyColumn::FWD_TAN>();
 	}
 	static void set(property_type p, float val)
 	{
-		p.widget->key().fwdTan.set(val);
+		p.widget->set<KeyColumn::FWD_TAN>(val);
 	}
 };
 
@@ -1184,7 +1196,7 @@ struct gui::DefaultEventSink<KeyFwdTanProperty>
 
 	void begin(const KeyFwdTanProperty& p, IComponent*)
 	{
-		m_init = p.widget->key().fwdTan.get();
+		m_init = p.widget->get<KeyColumn::FWD_TAN>();
 		m_op = std::make_unique<FwdMoveOp>(
 			p.widget->getKeysPtr(),
 			p.widget->getIndex(),
@@ -1193,7 +1205,7 @@ struct gui::DefaultEventSink<KeyFwdTanProperty>
 	void update(KeyFwdTanProperty& p, IComponent*, const value_type& val)
 	{
 		if (m_op)
-			m_op->update({ p.widget->key().time.get() + 1.0f, p.widget->key().value.get() + val });
+			m_op->update({ p.widget->get<KeyColumn::TIME>() + 1.0f, p.widget->get<KeyColumn::VALUE>() + val });
 	}
 	void end(KeyFwdTanProperty&, IComponent* source)
 	{
@@ -1219,11 +1231,11 @@ struct util::property_traits<KeyBwdTanProperty>
 
 	static float get(property_type p)
 	{
-		return p.widget->key().bwdTan.get();
+		return p.widget->get<KeyColumn::BWD_TAN>();
 	}
 	static void set(property_type p, float val)
 	{
-		p.widget->key().bwdTan.set(val);
+		p.widget->set<KeyColumn::BWD_TAN>(val);
 	}
 };
 
@@ -1234,7 +1246,7 @@ struct gui::DefaultEventSink<KeyBwdTanProperty>
 
 	void begin(const KeyBwdTanProperty& p, IComponent*)
 	{
-		m_init = p.widget->key().fwdTan.get();
+		m_init = p.widget->get<KeyColumn::FWD_TAN>();
 		m_op = std::make_unique<BwdMoveOp>(
 			p.widget->getKeysPtr(),
 			p.widget->getIndex(),
@@ -1243,7 +1255,7 @@ struct gui::DefaultEventSink<KeyBwdTanProperty>
 	void update(KeyBwdTanProperty& p, IComponent*, const value_type& val)
 	{
 		if (m_op)
-			m_op->update({ p.widget->key().time.get() - 1.0f, p.widget->key().value.get() - val });
+			m_op->update({ p.widget->get<KeyColumn::TIME>() - 1.0f, p.widget->get<KeyColumn::VALUE>() - val });
 	}
 	void end(KeyBwdTanProperty&, IComponent* source)
 	{
@@ -1294,7 +1306,8 @@ node::KeyWidget::KeyWidget(AnimationKey& key) :
 	time->setSensitivity(0.01f);
 	time->setNumberFormat("%.2f");
 
-	auto val = newChild<gui::DragInput<float, 1, KeyInputProperty>>(KeyInputProperty{ this, &Key<float>::value }, "Value");
+	auto val = newChild<gui::DragInput<float, 1, KeyInputProperty<KeyColumn::VALUE>>>(
+		KeyInputProperty<KeyColumn::VALUE>{ this }, "Value");
 	val->setSensitivity(0.01f);
 	val->setNumberFormat("%.2f");
 
@@ -1307,17 +1320,17 @@ node::KeyWidget::~KeyWidget()
 	m_keys->removeListener(*this);
 }
 
-void node::KeyWidget::onInsert(int i)
+void node::KeyWidget::onInsert(int i, int count)
 {
 	if (i <= m_index)
-		m_index++;
+		m_index += count;
 }
 
-void node::KeyWidget::onErase(int i)
+void node::KeyWidget::onErase(int i, int count)
 {
-	if (i < m_index)
-		m_index--;
-	else if (i == m_index) {
+	if (i + count <= m_index)
+		m_index -= count;
+	else if (i <= m_index) {
 		m_key = nullptr;
 		m_index = -1;
 		clearChildren();
@@ -1403,23 +1416,11 @@ std::unique_ptr<node::AnimationCurve::MoveOperation> node::CentreHandle::getMove
 	return std::make_unique<CentreMoveOp>(m_root->curve().getKeysPtr(), std::move(indices), pos);
 }
 
-node::BwdTangentHandle::BwdTangentHandle(AnimationKey& root) : KeyHandle(root)
-{
-	assert(m_root);
-	m_root->key().bwdTan.addListener(*this);
-}
-
-node::BwdTangentHandle::~BwdTangentHandle()
-{
-	if (m_root->valid())
-		m_root->key().bwdTan.removeListener(*this);
-}
-
 void node::BwdTangentHandle::frame(gui::FrameDrawer& fd)
 {
 	//(t, v) of this key is (0, 0) in our space
 	gui::Floats<2> tmp1 = fd.toGlobal({ 0.0f, 0.0f });
-	gui::Floats<2> tmp2 = fd.toGlobal({ -1.0f, -m_root->key().bwdTan.get() });
+	gui::Floats<2> tmp2 = fd.toGlobal({ -1.0f, -m_root->get<KeyColumn::BWD_TAN>() });
 	//tmp2 - tmp1 is some vector parallel with our desired handle
 	gui::Floats<2> tmp3 = (tmp2 - tmp1).matrix().normalized().array();
 	gui::Floats<2> tmp4 = tmp1 + HANDLE_LENGTH * (tmp2 - tmp1).matrix().normalized().array();
@@ -1452,30 +1453,12 @@ std::unique_ptr<node::AnimationCurve::MoveOperation> node::BwdTangentHandle::get
 		m_root->curve().getKeysPtr(), m_root->getIndex(), m_root->getHandleType() == AnimationKey::HandleType::ALIGNED);
 }
 
-void node::BwdTangentHandle::onSet(const float&)
-{
-	if (int i = m_root->getIndex(); i != 0)
-		m_root->curve().animationKey(i - 1).setDirty();
-}
-
-
-node::FwdTangentHandle::FwdTangentHandle(AnimationKey& root) : KeyHandle(root)
-{
-	assert(m_root);
-	m_root->key().fwdTan.addListener(*this);
-}
-
-node::FwdTangentHandle::~FwdTangentHandle()
-{
-	if (m_root->valid())
-		m_root->key().fwdTan.removeListener(*this);
-}
 
 void node::FwdTangentHandle::frame(gui::FrameDrawer& fd)
 {
 	//(t, v) of this key is (0, 0) in our space
 	gui::Floats<2> tmp1 = fd.toGlobal({ 0.0f, 0.0f });
-	gui::Floats<2> tmp2 = fd.toGlobal({ 1.0f, m_root->key().fwdTan.get() });
+	gui::Floats<2> tmp2 = fd.toGlobal({ 1.0f, m_root->get<KeyColumn::FWD_TAN>() });
 	//tmp2 - tmp1 is some vector parallel with our desired handle
 	gui::Floats<2> tmp3 = (tmp2 - tmp1).matrix().normalized().array();
 	gui::Floats<2> tmp4 = tmp1 + HANDLE_LENGTH * (tmp2 - tmp1).matrix().normalized().array();
@@ -1507,8 +1490,3 @@ std::unique_ptr<node::AnimationCurve::MoveOperation> node::FwdTangentHandle::get
 	return std::make_unique<FwdMoveOp>(
 		m_root->curve().getKeysPtr(), m_root->getIndex(), m_root->getHandleType() == AnimationKey::HandleType::ALIGNED);
 }
-
-void node::FwdTangentHandle::onSet(const float&)
-{
-	m_root->setDirty();
-}
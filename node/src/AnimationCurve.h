@@ -32,7 +32,7 @@ namespace node
 
 	class AnimationCurve final :
 		public gui::Composite,
-		public nif::VectorListener<Key<float>>,
+		public nif::KeyTableListener<float>,
 		public PropertyListener<float>,
 		public FlagSetListener<ControllerFlags>
 	{
@@ -50,9 +50,10 @@ namespace node
 
 		virtual void frame(gui::FrameDrawer& fd) override;
 
-		virtual void onInsert(int pos) override;
-		virtual void onErase(int pos) override;
+		virtual void onInsert(int pos, int count) override;
+		virtual void onErase(int pos, int count) override;
 		virtual void onMove(int from, int to) override;
+		virtual void onSet(KeyColumn column, int pos, int count) override;
 
 		virtual void onSet(const float&) override;
 		virtual void onRaise(ControllerFlags flags) override;
@@ -66,9 +67,9 @@ namespace node
 
 		AnimationKey& animationKey(int i) const;
 
-		ni_ptr<Vector<Key<float>>> getKeysPtr() const;
+		ni_ptr<KeyTable<float>> getKeysPtr() const;
 		ni_ptr<Property<KeyType>> getTypePtr() const;
-		Vector<Key<float>>& keys() { return m_data->keys; }
+		KeyTable<float>& keys() { return m_data->keys; }
 		Property<KeyType>& keyType() { return m_data->keyType; }
 
 		gui::Floats<2> getBounds() const;
@@ -78,7 +79,13 @@ namespace node
 
 		void setAxisLimits(const gui::Floats<2>& lims) { m_axisLims = lims; }
 
+		//Give our keys their current index, if it has changed since the last call
+		void refreshIndices();
+
 	private:
+		//Keys are renumbered on demand, so a run of insertions only renumbers once
+		void markStale(int i);
+
 		void buildClip(const gui::Floats<2>& lims, const gui::Floats<2>& resolution);
 		void addCurvePoints(gui::FrameDrawer& fd, int i, const gui::Floats<2>& lims, const gui::Floats<2>& resolution);
 
@@ -103,14 +110,15 @@ namespace node
 		float m_clipLength{ 0.0f };
 		gui::Floats<2> m_calcScale;//global scale of the current clip data
 		bool m_clipDirty{ true };
+		int m_firstStale{ -1 };//first key that may have the wrong index, or -1
 	};
 
 	//Root of the key handle. Responsible for positioning at the correct time/value,
 	//and for interpolating to the next key.
 	//Parents the interactive widgets.
+	//Does not listen to its key, the curve tells it when it has changed.
 	class AnimationKey final : 
 		public gui::Composite, 
-		public PropertyListener<float>,
 		public nif::PropertyListener<KeyType>
 	{
 	public:
@@ -126,13 +134,19 @@ namespace node
 
 		virtual void setTranslation(const gui::Floats<2>& t) override;
 
-		virtual void onSet(const float& val) override;
 		virtual void onSet(const KeyType& val) override;
+		//Our time or value was set
+		void onPositionSet();
 
 		AnimationCurve& curve() { return *m_curve; }
-		Key<float>& key() { return m_curve->keys().at(m_index); }
+		template<KeyColumn C>
+		float get() const { return m_curve->keys().get<C>(getIndex()); }
 
-		int getIndex() const { return m_index; }
+		int getIndex() const
+		{
+			m_curve->refreshIndices();
+			return m_index;
+		}
 		void setIndex(int i);//track this ourselves instead?
 
 		SelectionState getSelectionState() const { return m_selectionState; }
@@ -149,9 +163,6 @@ namespace node
 		//or NaN if the extrema are outside the interval.
 		gui::Floats<2> getExtrema();
 
-		void invalidate() { m_invalid = true; }
-		bool valid() const { return !m_invalid; }
-
 		bool getDirty() const { return m_dirty; }
 		void setDirty() { m_dirty = true; }
 
@@ -170,13 +181,12 @@ namespace node
 		float m_pHi[3];
 
 		bool m_dirty{ true };
-		bool m_invalid{ false };
 	};
 
 	//A widget for inputting key properties. Used in the side panel of the key editor.
 	class KeyWidget final :
 		public gui::Composite,
-		public VectorListener<Key<float>>,
+		public KeyTableListener<float>,
 		public PropertyListener<KeyType>
 	{
 	public:
@@ -184,16 +194,19 @@ namespace node
 		~KeyWidget();
 
 		//Keep our index correct
-		virtual void onInsert(int i) override;
-		virtual void onErase(int i) override;
+		virtual void onInsert(int i, int count) override;
+		virtual void onErase(int i, int count) override;
 		virtual void onMove(int from, int to) override;
 
 		//Show widgets for all relevant fields only
 		virtual void onSet(const KeyType& type) override;
 
 		int getIndex() const { return m_index; }
-		const ni_ptr<Vector<Key<float>>>& getKeysPtr() const { return m_keys; }
-		Key<float>& key() { return m_keys->at(m_index); }
+		const ni_ptr<KeyTable<float>>& getKeysPtr() const { return m_keys; }
+		template<KeyColumn C>
+		float get() const { return m_keys->get<C>(m_index); }
+		template<KeyColumn C>
+		void set(float val) { m_keys->set<C>(m_index, val); }
 		AnimationKey::HandleType getHandleType() const { return m_key->getHandleType(); }
 		void setHandleType(AnimationKey::HandleType type) { m_key->setHandleType(type); }
 
@@ -203,7 +216,7 @@ namespace node
 		//We need these to listen to type and index changes.
 		//We need to store them in order to unregister.
 		const ni_ptr<Property<KeyType>> m_type;
-		const ni_ptr<Vector<Key<float>>> m_keys;
+		const ni_ptr<KeyTable<float>> m_keys;
 		int m_index;
 	};
 
@@ -237,25 +250,21 @@ namespace node
 			std::vector<AnimationKey*>&& keys, const gui::Floats<2>& pos) override;
 	};
 
-	class BwdTangentHandle final : public KeyHandle, public PropertyListener<float>
+	class BwdTangentHandle final : public KeyHandle
 	{
 	public:
-		BwdTangentHandle(AnimationKey& root);
-		~BwdTangentHandle();
+		BwdTangentHandle(AnimationKey& root) : KeyHandle{ root } {}
 		virtual void frame(gui::FrameDrawer& fd) override;
 		virtual std::unique_ptr<AnimationCurve::MoveOperation> getMoveOp(
 			std::vector<AnimationKey*>&& keys, const gui::Floats<2>& pos) override;
-		virtual void onSet(const float&) override;
 	};
 
-	class FwdTangentHandle final : public KeyHandle, public PropertyListener<float>
+	class FwdTangentHandle final : public KeyHandle
 	{
 	public:
-		FwdTangentHandle(AnimationKey& root);
-		~FwdTangentHandle();
+		FwdTangentHandle(AnimationKey& root) : KeyHandle{ root } {}
 		virtual void frame(gui::FrameDrawer& fd) override;
 		virtual std::unique_ptr<AnimationCurve::MoveOperation> getMoveOp(
 			std::vector<AnimationKey*>&& keys, const gui::Floats<2>& pos) override;
-		virtual void onSet(const float&) override;
 	};
 }
@@ -22,7 +22,104 @@
 
 using namespace nif;
 
+//Provisional placement of nodes that are handed over before they can be arranged
+constexpr int PROVISIONAL_ROWS = 8;
+constexpr float PROVISIONAL_SPACING_X = 300.0f;
+constexpr float PROVISIONAL_SPACING_Y = 200.0f;
+
+void node::Constructor::handOver(gui::ConnectionHandler& target)
+{
+	for (; m_handedOver < m_nodes.size(); m_handedOver++) {
+		assert(m_nodes[m_handedOver]);
+		if (m_handedOver != 0) {
+			//The root stays at the origin, the rest go in columns to the right of it
+			int i = static_cast<int>(m_handedOver) - 1;
+			m_nodes[m_handedOver]->setTranslation({
+				PROVISIONAL_SPACING_X * static_cast<float>(i / PROVISIONAL_ROWS + 1),
+				PROVISIONAL_SPACING_Y * static_cast<float>(i % PROVISIONAL_ROWS) });
+		}
+		target.addChild(std::move(m_nodes[m_handedOver]));
+	}
+
+	translateModConnections(false);
+
+	std::vector<std::pair<gui::Connector*, gui::Connector*>> couplings;
+	resolveConnections(false, couplings);
+	for (auto&& pair : couplings) {
+		pair.first->setConnectionState(pair.second, true);
+		pair.second->setConnectionState(pair.first, true);
+	}
+}
+
+void node::Constructor::forget(gui::IComponent* node)
+{
+	for (size_t i = 0; i < m_handedOver; i++) {
+		if (m_live[i] == node) {
+			m_live[i] = nullptr;
+			break;
+		}
+	}
+}
+
 void node::Constructor::extractNodes(gui::ConnectionHandler& target, bool arrange)
+{
+	translateModConnections(true);
+
+	std::vector<std::pair<gui::Connector*, gui::Connector*>> couplings;
+	resolveConnections(true, couplings);
+
+	//Arranging needs the root, since the Positioner fixes its first node
+	if (arrange && m_live.size() > 1 && m_live[0]) {
+		//Collect every live node, taking back the ones we have already handed over
+		std::vector<std::unique_ptr<NodeBase>> nodes;
+		std::vector<int> newIndex(m_live.size(), -1);
+		for (size_t i = 0; i < m_live.size(); i++) {
+			std::unique_ptr<NodeBase> node;
+			if (i < m_handedOver) {
+				if (NodeBase* live = m_live[i]) {
+					if (gui::IComponent* parent = live->getParent()) {
+						if (gui::ComponentPtr c = parent->removeChild(live))
+							node.reset(static_cast<NodeBase*>(c.release()));
+					}
+				}
+			}
+			else
+				node = std::move(m_nodes[i]);
+
+			if (node) {
+				newIndex[i] = static_cast<int>(nodes.size());
+				nodes.push_back(std::move(node));
+			}
+		}
+
+		std::vector<Positioner::LinkInfo> links;
+		for (auto&& link : m_links) {
+			if (newIndex[link.node1] >= 0 && newIndex[link.node2] >= 0) {
+				links.push_back(link);
+				links.back().node1 = newIndex[link.node1];
+				links.back().node2 = newIndex[link.node2];
+			}
+		}
+
+		if (nodes.size() > 1)
+			target.addChild(std::make_unique<Positioner>(std::move(nodes), std::move(links)));
+		else if (nodes.size() == 1)
+			target.addChild(std::move(nodes.front()));
+	}
+	else {
+		for (; m_handedOver < m_nodes.size(); m_handedOver++)
+			target.addChild(std::move(m_nodes[m_handedOver]));
+	}
+	m_handedOver = m_nodes.size();
+	m_links.clear();
+
+	for (auto&& pair : couplings) {
+		pair.first->setConnectionState(pair.second, true);
+		pair.second->setConnectionState(pair.first, true);
+	}
+}
+
+void node::Constructor::translateModConnections(bool final)
 {
 	//Translate modifier connection requests into actual ConnectionInfo
 	struct Compare
@@ -33,22 +130,30 @@ void node::Constructor::extractNodes(gui::ConnectionHandler& target, bool arrang
 			return lhs->order.get() < rhs->order.get();
 		}
 	};
-	for (auto&& entry : m_modConnections) {
+	for (auto entry = m_modConnections.begin(); entry != m_modConnections.end();) {
+		//Until all the modifiers have been visited, we don't know which of them have nodes
+		if (!final && !std::all_of(entry->second.begin(), entry->second.end(),
+			[this](NiPSysModifier* mod) { return m_traversed.find(mod) != m_traversed.end(); }))
+		{
+			++entry;
+			continue;
+		}
+
 		//The particle system should always have a node
-		assert(m_objectMap.find(entry.first) != m_objectMap.end() && m_objectMap.find(entry.first)->second >= 0);
+		assert(m_objectMap.find(entry->first) != m_objectMap.end() && m_objectMap.find(entry->first)->second >= 0);
 
 		//Sort the list by mod order (should be already)
-		std::sort(entry.second.begin(), entry.second.end(), Compare{});
+		std::sort(entry->second.begin(), entry->second.end(), Compare{});
 
 		//for each modifier with a node, register a connection to the previous one
-		NiObject* prev = entry.first;
-		for (auto next = entry.second.begin(); next < entry.second.end(); ++next) {
+		NiObject* prev = entry->first;
+		for (auto next = entry->second.begin(); next < entry->second.end(); ++next) {
 			if (auto it = m_objectMap.find(*next); it != m_objectMap.end()) {
 				if (it->second >= 0) {
 					//This mod has a node
 					ConnectionInfo info;
 					info.object1 = prev;
-					info.field1 = prev == entry.first ? ParticleSystem::MODIFIERS : Modifier::NEXT_MODIFIER;
+					info.field1 = prev == entry->first ? ParticleSystem::MODIFIERS : Modifier::NEXT_MODIFIER;
 					info.object2 = *next;
 					info.field2 = Modifier::TARGET;
 					addConnection(info);
@@ -57,35 +162,44 @@ void node::Constructor::extractNodes(gui::ConnectionHandler& target, bool arrang
 				}
 			}
 		}
+		entry = m_modConnections.erase(entry);
 	}
+}
 
-	std::vector<std::pair<gui::Connector*, gui::Connector*>> couplings;
-	std::vector<Positioner::LinkInfo> linkInfo;
+void node::Constructor::resolveConnections(bool final, std::vector<std::pair<gui::Connector*, gui::Connector*>>& couplings)
+{
+	std::vector<ConnectionInfo> pending;
 
 	for (auto&& item : m_connections) {
-		gui::Connector* c1 = nullptr;
-		int i1;
-		if (auto it = m_objectMap.find(item.object1); it != m_objectMap.end()) {
-			if (it->second >= 0)
-				if (Field* f = m_nodes[it->second]->getField(item.field1)) {
-					c1 = f->connector;
-					i1 = it->second;
-				}
+		auto it1 = m_objectMap.find(item.object1);
+		auto it2 = m_objectMap.find(item.object2);
+		if (it1 == m_objectMap.end() || it1->second < 0 || it2 == m_objectMap.end() || it2->second < 0) {
+			//An end without a node may still get one, unless we have already visited it
+			if (!final && ((it1 == m_objectMap.end() && m_traversed.find(item.object1) == m_traversed.end()) ||
+				(it2 == m_objectMap.end() && m_traversed.find(item.object2) == m_traversed.end())))
+			{
+				pending.push_back(item);
+			}
+			continue;
 		}
 
+		int i1 = it1->second;
+		int i2 = it2->second;
+		assert(i1 < static_cast<int>(m_live.size()) && i2 < static_cast<int>(m_live.size()));
+
+		//Either node may have been removed after we handed it over
+		gui::Connector* c1 = nullptr;
+		if (m_live[i1])
+			if (Field* f = m_live[i1]->getField(item.field1))
+				c1 = f->connector;
+
 		gui::Connector* c2 = nullptr;
-		int i2;
-		if (auto it = m_objectMap.find(item.object2); it != m_objectMap.end()) {
-			if (it->second >= 0)
-				if (Field* f = m_nodes[it->second]->getField(item.field2)) {
-					c2 = f->connector;
-					i2 = it->second;
-				}
-		}
+		if (m_live[i2])
+			if (Field* f = m_live[i2]->getField(item.field2))
+				c2 = f->connector;
 
 		if (c1 && c2) {
 			couplings.push_back({ c1, c2 });
-			assert(i1 < static_cast<int>(m_nodes.size()) && i2 < static_cast<int>(m_nodes.size()));
 			if (i1 != i2) {
 				if (i1 > i2) {
 					//the positioner benefits from consistency
@@ -93,16 +207,16 @@ void node::Constructor::extractNodes(gui::ConnectionHandler& target, bool arrang
 					std::swap(c1, c2);
 				}
 
-				linkInfo.push_back({});
-				linkInfo.back().node1 = i1;
-				linkInfo.back().node2 = i2;
+				m_links.push_back({});
+				m_links.back().node1 = i1;
+				m_links.back().node2 = i2;
 
 				//Offset should be (node-space) translation(c1) - translation(c2).
 				//Connectors don't know their position until we start drawing them,
 				//but down the line we want to delegate to some layout manager to place gui components.
 				//This solution would mean that the connectors *do* know their position at this point.
 				//So let's make this work somehow:
-				linkInfo.back().offset = c2->getTranslation() - c1->getTranslation();
+				m_links.back().offset = c2->getTranslation() - c1->getTranslation();
 				//(later, we may not be able to assume that the local translation is in node space)
 
 				//The stiffness may have to be determined pairwise. 
@@ -110,31 +224,29 @@ void node::Constructor::extractNodes(gui::ConnectionHandler& target, bool arrang
 				//Unless we make the graph data accessible somehow, this will be hard to work with. Something to consider.
 				//Right now I think the only ones we want softer are the upwards references.
 				if (item.field1 == Node::OBJECT || item.field2 == Node::OBJECT)
-					linkInfo.back().stiffness = 0.1f;
+					m_links.back().stiffness = 0.1f;
 				else
-					linkInfo.back().stiffness = 1.0f;
+					m_links.back().stiffness = 1.0f;
 			}
 			//if somehow i1 == i2 we ignore it
 		}
 	}
-	m_connections.clear();
-
-	if (m_nodes.size() > 1) {
-		if (arrange)
-			target.addChild(std::make_unique<Positioner>(std::move(m_nodes), std::move(linkInfo)));
-		else {
-			for (auto&& node : m_nodes)
-				target.addChild(std::move(node));
-			m_nodes.clear();
-		}
-	}
-	else if (m_nodes.size() == 1)
-		target.addChild(std::move(m_nodes.front()));
 
-	for (auto&& pair : couplings) {
-		pair.first->setConnectionState(pair.second, true);
-		pair.second->setConnectionState(pair.first, true);
+	m_connections = std::move(pending);
+}
+
+bool node::Constructor::resume(size_t n)
+{
+	size_t limit = m_nodes.size() + n;
+	while (!m_deferred.empty() && m_nodes.size() < limit) {
+		m_objectStack = std::move(m_deferred.front());
+		m_deferred.pop_front();
+
+		m_nodeLimit = limit;
+		m_objectStack.back()->dispatch(*this);
+		m_objectStack.clear();
 	}
+	return m_deferred.empty();
 }
 
 void node::Constructor::addConnection(const node::ConnectionInfo& info)
@@ -152,6 +264,7 @@ void node::Constructor::addNode(NiObject* obj, std::unique_ptr<NodeBase>&& node)
 {
 	assert(obj && node);
 	m_objectMap.insert({ obj, m_nodes.size() });
+	m_live.push_back(node.get());
 	m_nodes.push_back(std::move(node));
 }
 
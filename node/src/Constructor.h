@@ -17,6 +17,7 @@
 //along with SVFX Editor. If not, see <https://www.gnu.org/licenses/>.
 
 #pragma once
+#include <deque>
 #include <exception>
 #include <list>
 #include <map>
@@ -24,6 +25,7 @@
 #include "nif.h"
 #include "ConnectionHandler.h"
 #include "nodes.h"
+#include "Positioner.h"
 
 namespace node
 {
@@ -52,8 +54,28 @@ namespace node
 		//should transfer ownership of our nodes to target and resolve our connections
 		//(the caller is responsible for making sure target is a valid receiver).
 		//Arranging of the nodes can be disabled (for testing, mostly).
+		//Nodes handed over earlier are taken back from wherever they are and arranged with the rest.
 		void extractNodes(gui::ConnectionHandler& target, bool arrange = true);
 
+		//Transfer the nodes created since the last call to target, at provisional positions,
+		//and resolve every connection whose ends are both known by now. Pass the same target each time,
+		//and finish with extractNodes.
+		void handOver(gui::ConnectionHandler& target);
+
+		//A node we have handed over has been removed by someone else. We must not touch it again.
+		void forget(gui::IComponent* node);
+
+		//To spread construction over several frames: once limit nodes have been created,
+		//objects we have not seen before are put aside (with the traversal state leading to them)
+		//instead of visited. 0 means no limit.
+		void setNodeLimit(size_t limit) { m_nodeLimit = limit; }
+
+		//Visit put aside objects until another n nodes have been created.
+		//Returns true if there is nothing left to visit.
+		bool resume(size_t n);
+
+		size_t nodeCount() const { return m_nodes.size(); }
+
 
 		//Used during traversal
 
@@ -68,13 +90,22 @@ namespace node
 
 		File& getFile() { return m_file; }
 
+	private:
+		//Modifier connections are translated once all the modifiers have been visited (or if final)
+		void translateModConnections(bool final);
+		//Connections we can't resolve yet are kept for later (unless final)
+		void resolveConnections(bool final, std::vector<std::pair<gui::Connector*, gui::Connector*>>& couplings);
+
 	private:
 		File& m_file;
 
 		std::vector<ConnectionInfo> m_connections;
 		std::map<NiParticleSystem*, std::vector<NiPSysModifier*>> m_modConnections;
 
-		std::vector<std::unique_ptr<NodeBase>> m_nodes;
+		std::vector<std::unique_ptr<NodeBase>> m_nodes;//null once handed over
+		std::vector<NodeBase*> m_live;//all our nodes by index (null if forgotten)
+		size_t m_handedOver{ 0 };
+		std::vector<Positioner::LinkInfo> m_links;//for the resolved connections
 		std::map<NiObject*, int> m_objectMap;//maps processed objects to an index in m_nodes (-1 if none)
 
 		//Traverse stack
@@ -83,6 +114,10 @@ namespace node
 		//Traverse history
 		std::set<NiObject*> m_traversed;
 
+		//Objects put aside, in the order we found them, with the object stack leading to them
+		size_t m_nodeLimit{ 0 };
+		std::deque<std::vector<ni_ptr<NiObject>>> m_deferred;
+
 		std::vector<std::string> m_warnings;
 	};
 
@@ -25,6 +25,15 @@ namespace node
 	template<typename T>
 	void Constructor::invoke(T& obj)
 	{
+		//Over the limit, anything new waits for resume (including any connections we would find here)
+		if (m_nodeLimit && m_nodes.size() >= m_nodeLimit && !m_objectStack.empty()
+			&& m_traversed.find(&obj) == m_traversed.end())
+		{
+			assert(m_objectStack.back().get() == static_cast<nif::NiObject*>(&obj));
+			m_deferred.push_back(m_objectStack);
+			return;
+		}
+
 		bool firstVisit = m_traversed.insert(&obj).second;
 		if (firstVisit) {
 			if (m_objectStack.empty()) {
@@ -53,13 +53,9 @@ namespace node
 
 				data->keyType.set(KEY_LINEAR);
 
-				data->keys.push_back();
-				data->keys.back().time.set(ctlr ? ctlr->startTime.get() : 0.0f);
-				data->keys.back().value.set(iplr->value.get());
-
-				data->keys.push_back();
-				data->keys.back().time.set(ctlr ? ctlr->stopTime.get() : 1.0f);
-				data->keys.back().value.set(iplr->value.get());
+				using Row = KeyTable<float>::Row;
+				data->keys.insert(0, Row{ ctlr ? ctlr->startTime.get() : 0.0f, iplr->value.get() });
+				data->keys.insert(1, Row{ ctlr ? ctlr->stopTime.get() : 1.0f, iplr->value.get() });
 
 				iplr->data.assign(data);
 			}
@@ -30,6 +30,10 @@
 
 constexpr const char* DOC_FILE_NAME = "block types.txt";
 
+//Time we may spend constructing nodes per frame while opening a file, and how many we construct between checks
+constexpr std::chrono::milliseconds CONSTRUCT_BUDGET{ 10 };
+constexpr size_t NODES_PER_STEP = 8;
+
 constexpr float SCALE_BASE = 1.1f;
 constexpr float SCALE_MIN = 0.23939f;
 constexpr float SCALE_MAX = 4.17725f;
@@ -89,8 +93,6 @@ node::Editor::Editor(const gui::Floats<2>& size, nif::File& file) : m_file{ &fil
 {
 	m_size = size;
 
-	NodeRoot* workArea{ nullptr };
-
 	try {
 		auto root = file.getRoot();
 		if (!root)
@@ -98,43 +100,35 @@ node::Editor::Editor(const gui::Floats<2>& size, nif::File& file) : m_file{ &fil
 
 		m_rootName = make_ni_ptr(std::static_pointer_cast<NiObjectNET>(root), &NiObjectNET::name);
 
-		workArea = newChild<NodeRoot>(file);
-
-		//Nodes
-		Constructor c(file);
-		root->receive(c);
+		m_workArea = newChild<NodeRoot>(file);
 
-		c.extractNodes(*workArea);
-
-		for (auto&& warning : c.warnings())
-			newChild<gui::MessageBox>("Warning", std::move(warning));
-
-		//Context menu
-		auto panel = newChild<gui::Panel>();
-		auto context = std::make_unique<gui::Popup>();
-		context->addChild(workArea->createAddMenu());
-		panel->setContextMenu(std::move(context));
+		//Transform the work area to some nice initial position (assuming the Root is at (0, 0))
+		m_workArea->setTranslation({ (m_size[0] - Root::WIDTH) / 8.0f, (m_size[1] - Root::HEIGHT) / 2.0f });
 
-		//Main menu additions
-		//Strange to add to main menu from here, no? Strictly speaking, we don't even know that there is a main menu.
-		auto main = std::make_unique<gui::MainMenu>("Add");
-		main->addChild(workArea->createAddMenu());
-		addChild(std::move(main));
+		//Nodes. Large files are constructed over several frames, starting from the root,
+		//and handed over to the work area as we go.
+		m_constructor = std::make_unique<Constructor>(file);
+		m_constructor->setNodeLimit(NODES_PER_STEP);
+		m_workArea->setConstructor(m_constructor.get());
+		root->dispatch(*m_constructor);
+		m_progress = newChild<gui::Text>("");
 
-		//Transform the work area to some nice initial position (assuming the Root is at (0, 0))
-		workArea->setTranslation({ (m_size[0] - Root::WIDTH) / 8.0f, (m_size[1] - Root::HEIGHT) / 2.0f });
+		construct();
 	}
 	catch (const std::exception& e) {
-		clearChildren();
-		m_rootName.reset();
-		workArea = newChild<NodeRoot>(file);
-		newChild<gui::MessageBox>("Error", e.what());
-
-		//Now we have the appearance we should have, but no way to add nodes. It wouldn't make sense to. 
-		//better to force the user to open another file.
-		//Still, I can't shake the feeling that this whole setup is a bit stupid.
+		fail(e);
+		return;
 	}
 
+	addHelpMenu();
+}
+
+node::Editor::~Editor()
+{
+}
+
+void node::Editor::addHelpMenu()
+{
 	//Main menu additions
 	auto help = std::make_unique<gui::MainMenu>("Help");
 
@@ -147,23 +141,86 @@ node::Editor::Editor(const gui::Floats<2>& size, nif::File& file) : m_file{ &fil
 	addChild(std::move(help));
 }
 
-node::Editor::~Editor()
+void node::Editor::frame(gui::FrameDrawer& fd)
 {
+	if (m_constructor) {
+		try {
+			construct();
+		}
+		catch (const std::exception& e) {
+			fail(e);
+		}
+	}
+
+	Composite::frame(fd);
 }
 
-void node::Editor::frame(gui::FrameDrawer& fd)
+void node::Editor::construct()
 {
-	Composite::frame(fd);
+	assert(m_constructor && m_workArea && m_progress);
+
+	auto deadline = std::chrono::steady_clock::now() + CONSTRUCT_BUDGET;
+	bool done;
+	while (!(done = m_constructor->resume(NODES_PER_STEP)) && std::chrono::steady_clock::now() < deadline);
+
+	if (!done) {
+		m_constructor->handOver(*m_workArea);
+		m_progress->setText("Creating nodes... " + std::to_string(m_constructor->nodeCount()));
+		return;
+	}
+
+	removeChild(m_progress);
+	m_progress = nullptr;
+
+	//The rest are handed over, and everything is arranged as a whole
+	m_workArea->setConstructor(nullptr);
+	m_constructor->extractNodes(*m_workArea);
+
+	for (auto&& warning : m_constructor->warnings())
+		newChild<gui::MessageBox>("Warning", std::move(warning));
+
+	m_constructor.reset();
+
+	//Context menu
+	auto panel = newChild<gui::Panel>();
+	auto context = std::make_unique<gui::Popup>();
+	context->addChild(m_workArea->createAddMenu());
+	panel->setContextMenu(std::move(context));
+
+	//Main menu additions
+	//Strange to add to main menu from here, no? Strictly speaking, we don't even know that there is a main menu.
+	auto main = std::make_unique<gui::MainMenu>("Add");
+	main->addChild(m_workArea->createAddMenu());
+	addChild(std::move(main));
+}
+
+void node::Editor::fail(const std::exception& e)
+{
+	clearChildren();
+	m_constructor.reset();
+	m_progress = nullptr;
+	m_rootName.reset();
+	m_workArea = newChild<NodeRoot>(*m_file);
+	newChild<gui::MessageBox>("Error", e.what());
+
+	//Now we have the appearance we should have, but no way to add nodes. It wouldn't make sense to. 
+	//better to force the user to open another file.
+	//Still, I can't shake the feeling that this whole setup is a bit stupid.
+
+	addHelpMenu();
 }
 
-void node::Editor::preWriteProc()
+std::unique_ptr<nif::File::WriteJob> node::Editor::prepareWrite()
 {
+	std::unique_ptr<nif::File::WriteJob> job;
 	if (m_file) {
-		if (auto&& root = m_file->getRoot()) {
-			AttachPointData::PreWriteProcessor attachT(*m_file);
-			root->receive(attachT);
-		}
+		AttachPointData::PreWriteProcessor attachT(*m_file);
+
+		nif::Pipeline pipeline(nif::Pipeline::Order::CHILDREN_FIRST);
+		pipeline.add(attachT);
+		job = m_file->prepareWrite(pipeline);
 	}
+	return job;
 }
 
 void node::Editor::setProjectName(const std::string& name)
@@ -273,6 +330,13 @@ void ControlsInfoWindow::frame(gui::FrameDrawer& fd)
 		fd.setWheelHandled();
 }
 
+gui::ComponentPtr node::Editor::NodeRoot::removeChild(IComponent* c)
+{
+	if (m_constructor)
+		m_constructor->forget(c);
+	return ConnectionHandler::removeChild(c);
+}
+
 void node::Editor::NodeRoot::frame(gui::FrameDrawer& fd)
 {
 	assert(getParent());
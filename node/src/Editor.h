@@ -26,6 +26,8 @@ namespace node
 {
 	using namespace nif;
 
+	class Constructor;
+
 	class Editor final :
 		public gui::Composite
 	{
@@ -36,9 +38,16 @@ namespace node
 
 		virtual void frame(gui::FrameDrawer& fd) override;
 
-		void preWriteProc();
+		//Run our pre-write processing and prepare our file for writing, in one pass over its objects
+		[[nodiscard]] std::unique_ptr<nif::File::WriteJob> prepareWrite();
 		void setProjectName(const std::string& name);
 
+	private:
+		//Construct another batch of nodes, and hand them all to the work area once complete
+		void construct();
+		void fail(const std::exception& e);
+		void addHelpMenu();
+
 	private:
 		class NodeRoot final : public gui::ConnectionHandler
 		{
@@ -46,15 +55,26 @@ namespace node
 			NodeRoot(nif::File& file) : m_file{ file } {}
 			virtual void frame(gui::FrameDrawer& fd) override;
 
+			virtual gui::ComponentPtr removeChild(IComponent* c) override;
+
 			std::unique_ptr<IComponent> createAddMenu();
 			template<typename T> void addNode();
 
+			//Nodes removed while we are still constructing must be forgotten by the Constructor
+			void setConstructor(Constructor* c) { m_constructor = c; }
+
 		private:
 			nif::File& m_file;
+			Constructor* m_constructor{ nullptr };
 		};
 
 		nif::File* m_file{ nullptr };
 		ni_ptr<Property<std::string>> m_rootName;
+
+		//While we are still constructing nodes
+		std::unique_ptr<Constructor> m_constructor;
+		NodeRoot* m_workArea{ nullptr };
+		gui::Text* m_progress{ nullptr };
 	};
 }
 
@@ -116,7 +116,7 @@ struct util::property_traits<AttachTProperty>
 	static std::string get(const AttachTProperty& p) 
 	{ 
 		assert(p.target && p.target->size() == 1);
-		auto&& s = p.target->at(0).get();
+		auto&& s = p.target->at(0).view();
 		assert(s.size() > 9 && s[9] == '&');
 		if (s.size() > 10)
 			return s.substr(10);
@@ -163,45 +163,30 @@ node::AttachPointData::PreWriteProcessor::PreWriteProcessor(File& file) :
 
 void node::AttachPointData::PreWriteProcessor::traverse(NiNode& obj)
 {
-	m_current = &obj;
-
-	for (auto&& data : obj.extraData) {
-		assert(data);
-		data->receive(*this);
-	}
-
-	for (auto&& child : obj.children) {
-		assert(child);
-		child->receive(*this);
-	}
-
-	if (&obj == m_file.getRoot().get()) {
-		if (m_needMulti != (m_multiTech != nullptr)) {
-			if (m_needMulti) {
-				//create new
-				auto data = m_file.create<NiStringsExtraData>();
-				data->name.set("AttachT");
-				data->strings.resize(1);
-				data->strings.at(0).set("MultiTechnique");
-				obj.extraData.add(data);
-			}
-			else {
-				//remove existing
-				obj.extraData.remove(m_multiTech);
-			}
-		}
-	}
+	if (entry().parent == -1)
+		finish(obj);
 }
 
 void node::AttachPointData::PreWriteProcessor::traverse(BSFadeNode& obj)
 {
-	PreWriteProcessor::traverse(static_cast<NiNode&>(obj));
+	if (entry().parent == -1)
+		finish(obj);
 }
 
 void node::AttachPointData::PreWriteProcessor::traverse(NiStringsExtraData& obj)
 {
-	if (obj.name.get() == "AttachT") {
-		if (m_current == m_file.getRoot().get()) {
+	//We look at the extra data of nodes that are reached through other nodes.
+	//Not billboard nodes, for now.
+	int owner = entry().parent;
+	if (owner == -1)
+		return;
+	for (int i = owner; i != -1; i = table()[i].parent) {
+		if (table()[i].type != NiNode::TYPE && table()[i].type != BSFadeNode::TYPE)
+			return;
+	}
+
+	if (obj.name.view() == "AttachT") {
+		if (table()[owner].parent == -1) {
 			if (obj.strings.size() > 0 && obj.strings.at(0).get() == "MultiTechnique")
 				m_multiTech = &obj;
 		}
@@ -212,6 +197,24 @@ void node::AttachPointData::PreWriteProcessor::traverse(NiStringsExtraData& obj)
 	}
 }
 
+void node::AttachPointData::PreWriteProcessor::finish(NiNode& root)
+{
+	if (m_needMulti != (m_multiTech != nullptr)) {
+		if (m_needMulti) {
+			//create new
+			auto data = m_file.create<NiStringsExtraData>();
+			data->name.set("AttachT");
+			data->strings.resize(1);
+			data->strings.at(0).set("MultiTechnique");
+			root.extraData.add(data);
+		}
+		else {
+			//remove existing
+			root.extraData.remove(m_multiTech);
+		}
+	}
+}
+
 
 node::DummyExtraData::DummyExtraData(const ni_ptr<nif::NiExtraData>& obj) :
 	ExtraData(obj)
@@ -83,20 +83,23 @@ namespace node
 	class AttachPointData final : public ExtraData
 	{
 	public:
-		class PreWriteProcessor final : public NiTraverser
+		//Adds/removes the root's MultiTechnique as needed.
+		//Run it children first, so that the root is reached after all the extra data (the root is
+		//reached last, whatever is shared). Owners are found through the table's parents.
+		class PreWriteProcessor final : public PipelinePass
 		{
 		public:
 			PreWriteProcessor(File& file);
 
 			virtual void traverse(NiNode& obj) override;
 			virtual void traverse(BSFadeNode& obj) override;
-			//virtual void traverse(NiBillboardNode& obj) override;
-
 			virtual void traverse(NiStringsExtraData& obj) override;
 
+		private:
+			void finish(NiNode& root);
+
 		private:
 			File& m_file;
-			NiNode* m_current{ nullptr };
 			NiStringsExtraData* m_multiTech{ nullptr };
 			bool m_needMulti{ false };
 		};
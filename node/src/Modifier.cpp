@@ -126,7 +126,7 @@ void node::Modifier::Device::addController(const ni_ptr<NiPSysModifierCtlr>& ctl
 				{ ctlr, std::make_unique<PropertySyncer<std::string>>(make_ni_ptr(ctlr, &NiPSysModifierCtlr::modifierName)) });
 
 			m_mod->name.addListener(*m_ctlrs.back().second);
-			m_ctlrs.back().second->onSet(m_mod->name.get());
+			m_ctlrs.back().second->onSet(m_mod->name.view());
 			if (m_ifc)
 				m_ifc->addController(ctlr);
 		}
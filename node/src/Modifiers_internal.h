@@ -119,7 +119,7 @@ namespace node
 			if (auto&& target = obj.target.assigned()) {
 				for (auto&& ctlr : target->controllers) {
 					t.current = ctlr;
-					ctlr->receive(t);
+					ctlr->dispatch(t);
 				}
 			}
 		}
@@ -101,7 +101,7 @@ namespace node
 			for (auto&& child : obj.children) {
 				assert(child);
 				ctor.pushObject(child);
-				child->receive(ctor);
+				child->dispatch(ctor);
 				ctor.popObject();
 			}
 			return true; 
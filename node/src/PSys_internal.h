@@ -201,17 +201,17 @@ namespace node
 			for (auto&& mod : obj.modifiers) {
 				assert(mod);
 				ctor.pushObject(mod);
-				mod->receive(ctor);
+				mod->dispatch(ctor);
 				ctor.popObject();
 			}
 			if (auto&& shader = obj.shaderProperty.assigned()) {
 				ctor.pushObject(shader);
-				shader->receive(ctor);
+				shader->dispatch(ctor);
 				ctor.popObject();
 			}
 			if (auto&& alpha = obj.alphaProperty.assigned()) {
 				ctor.pushObject(alpha);
-				alpha->receive(ctor);
+				alpha->dispatch(ctor);
 				ctor.popObject();
 			}
 
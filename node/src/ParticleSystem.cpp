@@ -197,6 +197,8 @@ public:
 			m_psys->modifiers.at(pos)->order.set(pos);
 	}
 	virtual void onErase(int pos) override { ModifiersField::onInsert(pos); }
+	virtual void onInsertRange(int pos, int) override { ModifiersField::onInsert(pos); }
+	virtual void onEraseRange(int pos, int) override { ModifiersField::onInsert(pos); }
 };
 
 class node::ParticleSystem::MaxCountField final : public Field
@@ -246,7 +248,7 @@ node::ParticleSystem::ParticleSystem(
 
 	//Controllers and modifiers are all handled by our ModifiersField.
 
-	m_subtexCount->set(node_conversion<SubtextureCount>::from(data->subtexOffsets.get()));
+	m_subtexCount->set(node_conversion<SubtextureCount>::from(data->subtexOffsets.view()));
 	m_subtexCount->addListener(m_subtexLsnr);
 
 	setClosable(true);
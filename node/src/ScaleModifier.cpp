@@ -63,7 +63,7 @@ public:
 		item->newChild<AddButton>(*m_scales);
 		
 		m_scales->addListener(*this);
-		onSet(m_scales->get());
+		onSet(m_scales->view());
 	}
 
 	virtual void onSet(const std::vector<float>& v) override
@@ -119,43 +119,49 @@ private:
 		virtual bool reversible() const override { return m_from != m_to; }
 	};
 
+	//The segment commands hold shared snapshots of the scales before and after, not copies.
+	//Doing and undoing just swaps which one the Property holds.
 	class AddSegment final : public gui::ICommand
 	{
 		Property<std::vector<float>>& m_trgt;
-		std::vector<float> m_old;
-		std::vector<float> m_new;
+		Property<std::vector<float>>::snapshot_type m_old;
+		Property<std::vector<float>>::snapshot_type m_new;
 
 	public:
 		AddSegment(Property<std::vector<float>>& trgt) : m_trgt{ trgt } {}
 
 		virtual void execute() override 
 		{
-			if (m_new.empty()) {
+			if (!m_new) {
 				//this is the first time we're executed
-				if (m_old = m_trgt.get(); m_old.size() != std::numeric_limits<decltype(m_old)::size_type>::max()) {//very, very safe
-					if (m_old.size() < 2) {
+				m_old = m_trgt.snapshot();
+				const std::vector<float>& old = *m_old;
+				if (old.size() != std::numeric_limits<std::vector<float>::size_type>::max()) {//very, very safe
+					std::vector<float> result;
+					if (old.size() < 2) {
 						//could happen on importing
-						if (m_old.empty())
-							m_new = { 0.0f, 1.0f };
+						if (old.empty())
+							result = { 0.0f, 1.0f };
 						else
-							m_new = { m_old.front(), m_old.front() };
+							result = { old.front(), old.front() };
 					}
-					else if (m_old.size() == 2) {
-						m_new = { m_old.front(), 0.5f * (m_old.back() + m_old.front()), m_old.back() };
+					else if (old.size() == 2) {
+						result = { old.front(), 0.5f * (old.back() + old.front()), old.back() };
 					}
 					else {
-						m_new.resize(m_old.size() + 1);
+						result.resize(old.size() + 1);
 
-						Eigen::VectorXf vals(m_old.size());
+						Eigen::VectorXf vals(old.size());
 						for (int i = 0; i < vals.size(); i++)
-							vals[i] = m_old[i];
+							vals[i] = old[i];
 
 						math::SplineInterpolant spline(vals);
-						vals = spline.eval(Eigen::VectorXf::LinSpaced(m_new.size(), 0.0f, 1.0f));
+						vals = spline.eval(Eigen::VectorXf::LinSpaced(result.size(), 0.0f, 1.0f));
 
 						for (int i = 0; i < vals.size(); i++)
-							m_new[i] = std::max(vals[i], 0.0f);
+							result[i] = std::max(vals[i], 0.0f);
 					}
+					m_new = std::make_shared<const std::vector<float>>(std::move(result));
 				}
 				else
 					m_new = m_old;
@@ -175,32 +181,35 @@ private:
 	class RemoveSegment final : public gui::ICommand
 	{
 		Property<std::vector<float>>& m_trgt;
-		std::vector<float> m_old;
-		std::vector<float> m_new;
+		Property<std::vector<float>>::snapshot_type m_old;
+		Property<std::vector<float>>::snapshot_type m_new;
 
 	public:
 		RemoveSegment(Property<std::vector<float>>& trgt) : m_trgt{ trgt } {}
 
 		virtual void execute() override 
 		{
-			if (m_new.empty()) {
-				m_old = m_trgt.get();
-				if (m_old.size() < 3)
+			if (!m_new) {
+				m_old = m_trgt.snapshot();
+				const std::vector<float>& old = *m_old;
+				if (old.size() < 3)
 					m_new = m_old;
-				else if (m_old.size() == 3)
-					m_new = { m_old.front(), m_old.back() };
+				else if (old.size() == 3)
+					m_new = std::make_shared<const std::vector<float>>(std::vector<float>{ old.front(), old.back() });
 				else {
-					m_new.resize(m_old.size() - 1);
+					std::vector<float> result(old.size() - 1);
 
-					Eigen::VectorXf vals(m_old.size());
+					Eigen::VectorXf vals(old.size());
 					for (int i = 0; i < vals.size(); i++)
-						vals[i] = m_old[i];
+						vals[i] = old[i];
 
 					math::SplineInterpolant spline(vals);
-					vals = spline.eval(Eigen::VectorXf::LinSpaced(m_new.size(), 0.0f, 1.0f));
+					vals = spline.eval(Eigen::VectorXf::LinSpaced(result.size(), 0.0f, 1.0f));
 
 					for (int i = 0; i < vals.size(); i++)
-						m_new[i] = std::max(vals[i], 0.0f);
+						result[i] = std::max(vals[i], 0.0f);
+
+					m_new = std::make_shared<const std::vector<float>>(std::move(result));
 				}
 			}
 			m_trgt.set(m_new);
@@ -209,7 +218,7 @@ private:
 		{
 			m_trgt.set(m_old);
 		}
-		virtual bool reversible() const override { return m_old.size() > 2; }
+		virtual bool reversible() const override { return m_old && m_old->size() > 2; }
 	};
 
 	class Controls : public gui::SimpleHandles
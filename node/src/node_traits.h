@@ -37,9 +37,10 @@ struct util::property_traits<nif::ni_ptr<nif::Property<T>>>
 {
 	using property_type = nif::ni_ptr<nif::Property<T>>;
 	using value_type = T;
-	using get_type = T;
+	using get_type = const T&;
 
-	static T get(const property_type& p) { return p->get(); }
+	//Widgets read every frame, don't copy strings and vectors
+	static const T& get(const property_type& p) { return p->view(); }
 	static void set(property_type& p, const T& data) { p->set(data); }
 	static void set(property_type& p, T&& data) { p->set(std::move(data)); }
 };
@@ -49,9 +50,9 @@ struct util::property_traits<nif::Property<T>>
 {
 	using property_type = nif::Property<T>;
 	using value_type = T;
-	using get_type = T;
+	using get_type = const T&;
 
-	static T get(const property_type& p) { return p.get(); }
+	static const T& get(const property_type& p) { return p.view(); }
 	static void set(property_type& p, const T& data) { p.set(data); }
 	static void set(property_type& p, T&& data) { p.set(std::move(data)); }
 };
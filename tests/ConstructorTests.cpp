@@ -17,15 +17,48 @@
 //along with SVFX Editor. If not, see <https://www.gnu.org/licenses/>.
 
 #include "pch.h"
+#include <tuple>
+#include <typeinfo>
 #include "CppUnitTest.h"
 #include "CommonTests.h"
 #include "Constructor.inl"
+#include "Timer.h"
 
 namespace creation
 {
 	using namespace Microsoft::VisualStudio::CppUnitTestFramework;
 	using namespace nif;
 
+	//Every connection under root, as (node type, connector number) of either end.
+	//Independent of node order, so constructions can be compared even if they visit objects in a different order.
+	inline std::multiset<std::tuple<std::string, int, std::string, int>> connectionSignature(gui::ConnectionHandler& root)
+	{
+		class ConnectorCollector final : public gui::DescendingVisitor
+		{
+		public:
+			virtual void visit(gui::Connector& c) override { connectors.push_back(&c); }
+			std::vector<gui::Connector*> connectors;
+		};
+
+		std::map<gui::Connector*, std::pair<std::string, int>> ends;
+		for (auto&& node : root.getChildren()) {
+			ConnectorCollector collector;
+			node->accept(collector);
+			for (int i = 0; i < static_cast<int>(collector.connectors.size()); i++)
+				ends[collector.connectors[i]] = { typeid(*node).name(), i };
+		}
+
+		std::multiset<std::tuple<std::string, int, std::string, int>> result;
+		for (auto&& end : ends) {
+			for (gui::Connector* other : end.first->getConnected()) {
+				auto it = ends.find(other);
+				Assert::IsTrue(it != ends.end());
+				result.insert({ end.second.first, end.second.second, it->second.first, it->second.second });
+			}
+		}
+		return result;
+	}
+
 	TEST_CLASS(ConstructorTests)
 	{
 	public:
@@ -82,5 +115,74 @@ namespace creation
 			Assert::IsTrue(areConnected(c1_next, c3_target));
 			Assert::IsTrue(c3_next->getConnected().empty());
 		}
+
+		//Construction spread over several steps should give the same nodes as in one go
+		TEST_METHOD(Resume)
+		{
+			File file(File::Version::SKYRIM_SE);
+			for (int i = 0; i < 3; i++) {
+				auto node = file.create<NiNode>();
+				node->extraData.add(file.create<NiStringExtraData>());
+				file.getRoot()->children.add(node);
+			}
+
+			node::Constructor whole(file);
+			file.getRoot()->receive(whole);
+			gui::ConnectionHandler wholeRoot;
+			whole.extractNodes(wholeRoot, false);
+
+			node::Constructor parts(file);
+			parts.setNodeLimit(1);
+			file.getRoot()->receive(parts);
+			Assert::IsTrue(parts.nodeCount() == 1);
+
+			//Nodes are handed over as they are made
+			gui::ConnectionHandler partsRoot;
+			parts.handOver(partsRoot);
+			Assert::IsTrue(partsRoot.getChildren().size() == 1);
+
+			int steps = 0;
+			while (!parts.resume(1)) {
+				steps++;
+				parts.handOver(partsRoot);
+				Assert::IsTrue(partsRoot.getChildren().size() == parts.nodeCount());
+			}
+			Assert::IsTrue(steps > 1);
+
+			parts.extractNodes(partsRoot, false);
+
+			Assert::IsTrue(wholeRoot.getChildren().size() == 7);
+			Assert::IsTrue(partsRoot.getChildren().size() == wholeRoot.getChildren().size());
+
+			//and connected the same way
+			auto wholeLinks = connectionSignature(wholeRoot);
+			Assert::IsFalse(wholeLinks.empty());
+			Assert::IsTrue(connectionSignature(partsRoot) == wholeLinks);
+		}
+
+		//Construction time through receive and through the dispatch table. A benchmark, it doesn't fail.
+		TEST_METHOD(Dispatch)
+		{
+			constexpr int NODES = 1000;
+
+			File file(File::Version::SKYRIM_SE);
+			for (int i = 0; i < NODES; i++) {
+				auto node = file.create<NiNode>();
+				node->extraData.add(file.create<NiStringExtraData>());
+				file.getRoot()->children.add(node);
+			}
+
+			for (Dispatch mode : { Dispatch::VIRTUAL, Dispatch::TABLE }) {
+				Timer<long long, std::micro> timer;
+				node::Constructor ctor(file);
+				ctor.setDispatch(mode);
+				file.getRoot()->dispatch(ctor);
+				long long us = timer.elapsed();
+				Assert::IsTrue(ctor.nodeCount() == 2 * NODES + 1);
+
+				std::string name = mode == Dispatch::TABLE ? "table" : "virtual";
+				Logger::WriteMessage(("Constructor, " + name + " dispatch: " + std::to_string(us) + " us\n").c_str());
+			}
+		}
 	};
 }
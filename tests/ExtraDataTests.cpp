@@ -67,7 +67,9 @@ namespace nodes
 				node2->extraData.add(data2);
 
 				node::AttachPointData::PreWriteProcessor t(file);
-				root->receive(t);
+				Pipeline pipeline(Pipeline::Order::CHILDREN_FIRST);
+				pipeline.add(t);
+				pipeline.run(file.objects());
 
 				Assert::IsTrue(root->extraData.size() == 1);
 				for (auto&& data : root->extraData) {
@@ -87,7 +89,9 @@ namespace nodes
 				root->extraData.add(data);
 
 				node::AttachPointData::PreWriteProcessor t(file);
-				root->receive(t);
+				Pipeline pipeline(Pipeline::Order::CHILDREN_FIRST);
+				pipeline.add(t);
+				pipeline.run(file.objects());
 
 				Assert::IsTrue(root->extraData.size() == 1);
 				for (auto&& data : root->extraData) {
@@ -114,7 +118,9 @@ namespace nodes
 				root->extraData.add(data2);
 
 				node::AttachPointData::PreWriteProcessor t(file);
-				root->receive(t);
+				Pipeline pipeline(Pipeline::Order::CHILDREN_FIRST);
+				pipeline.add(t);
+				pipeline.run(file.objects());
 
 				Assert::IsTrue(root->extraData.size() == 1);
 				for (auto&& data : root->extraData) {